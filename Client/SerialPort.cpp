@@ -1,17 +1,34 @@
 #include "SerialPort.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <utility>
+#include <vector>
+#include <ws2tcpip.h>
 #include "..\3party\nlohmann\json.hpp"
 
 
 HANDLE hConsole;
 std::string port;
 int baudRate;
+std::string solvedGamesPath;
+int statsPollSeconds = 0;
 void setColor(int textColor) {
     HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
     SetConsoleTextAttribute(hConsole, textColor);
 }
 
+// The driver acts on XON/XOFF; drop any that still reach the data
+static void removeFlowControl(std::string& data) {
+    data.erase(std::remove_if(data.begin(), data.end(), [](char c) { return c == XON_CHAR || c == XOFF_CHAR; }), data.end());
+}
+
 bool SerialCommunication::connect(const std::string& portName, int baudRate) {
+    if (portName.rfind("tcp://", 0) == 0) {
+        return connectSocket(portName.substr(6));
+    }
+
     hSerial = CreateFile(portName.c_str(), GENERIC_READ | GENERIC_WRITE, 0, 0, OPEN_EXISTING, 0, 0);
     if (hSerial == INVALID_HANDLE_VALUE) {
         std::cerr << "   : " << portName << std::endl;
@@ -24,6 +41,10 @@ bool SerialCommunication::connect(const std::string& portName, int baudRate) {
     dcb.ByteSize = 8;
     dcb.StopBits = ONESTOPBIT;
     dcb.Parity = NOPARITY;
+    // The sketch sends XOFF when its receive ring is 3/4 full and XON once it has drained
+    dcb.fOutX = TRUE;
+    dcb.XonChar = XON_CHAR;
+    dcb.XoffChar = XOFF_CHAR;
 
     if (!SetCommState(hSerial, &dcb)) {
         std::cerr << "    ." << std::endl;
@@ -48,34 +69,358 @@ bool SerialCommunication::connect(const std::string& portName, int baudRate) {
     return true;
 }
 
+// address: "host:port"
+bool SerialCommunication::connectSocket(const std::string& address) {
+    size_t colon = address.rfind(':');
+    if (colon == std::string::npos) {
+        std::cerr << "Invalid server address, expected tcp://host:port: " << address << std::endl;
+        return false;
+    }
+    std::string host = address.substr(0, colon);
+    std::string service = address.substr(colon + 1);
+
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        std::cerr << "Failed to initialize Winsock." << std::endl;
+        return false;
+    }
+
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+    addrinfo* addresses = nullptr;
+    if (getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses) != 0) {
+        std::cerr << "Failed to resolve server address: " << address << std::endl;
+        WSACleanup();
+        return false;
+    }
+
+    for (addrinfo* candidate = addresses; candidate != nullptr; candidate = candidate->ai_next) {
+        hSocket = socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+        if (hSocket == INVALID_SOCKET) {
+            continue;
+        }
+        if (::connect(hSocket, candidate->ai_addr, (int)candidate->ai_addrlen) == 0) {
+            break;
+        }
+        closesocket(hSocket);
+        hSocket = INVALID_SOCKET;
+    }
+    freeaddrinfo(addresses);
+
+    if (hSocket == INVALID_SOCKET) {
+        std::cerr << "Failed to connect to server: " << address << std::endl;
+        WSACleanup();
+        return false;
+    }
+
+    // Commands are small and latency-bound, do not wait for Nagle
+    BOOL noDelay = TRUE;
+    setsockopt(hSocket, IPPROTO_TCP, TCP_NODELAY, (const char*)&noDelay, sizeof(noDelay));
+    return true;
+}
+
+bool SerialCommunication::isConnected() const {
+    return hSerial != INVALID_HANDLE_VALUE || hSocket != INVALID_SOCKET;
+}
+
+bool SerialCommunication::writeBytes(const std::string& message) {
+    if (hSocket != INVALID_SOCKET) {
+        size_t sent = 0;
+        while (sent < message.size()) {
+            int result = send(hSocket, message.c_str() + sent, (int)(message.size() - sent), 0);
+            if (result == SOCKET_ERROR) {
+                return false;
+            }
+            sent += result;
+        }
+        return true;
+    }
+
+    DWORD bytesWritten;
+    return WriteFile(hSerial, message.c_str(), message.size(), &bytesWritten, nullptr) && bytesWritten == message.size();
+}
+
+// Mirrors the COM port timeouts: waits up to firstByteTimeout ms for the reply,
+// then keeps reading until the line is silent for intervalTimeout ms
+bool SerialCommunication::readSocket(char* buffer, DWORD size, DWORD& bytesRead, DWORD firstByteTimeout, DWORD intervalTimeout) {
+    bytesRead = 0;
+    DWORD timeout = firstByteTimeout;
+    while (bytesRead < size) {
+        fd_set readSet;
+        FD_ZERO(&readSet);
+        FD_SET(hSocket, &readSet);
+        timeval wait = { (long)(timeout / 1000), (long)(timeout % 1000) * 1000 };
+        int ready = select(0, &readSet, nullptr, nullptr, &wait);
+        if (ready == SOCKET_ERROR) {
+            return false;
+        }
+        if (ready == 0) {
+            return true;
+        }
+
+        int result = recv(hSocket, buffer + bytesRead, (int)(size - bytesRead), 0);
+        if (result <= 0) {
+            return bytesRead > 0;
+        }
+        bytesRead += result;
+        timeout = intervalTimeout;
+    }
+    return true;
+}
+
 void SerialCommunication::disconnect() {
+    stopEventReader();
     if (hSerial != INVALID_HANDLE_VALUE) {
         CloseHandle(hSerial);
         hSerial = INVALID_HANDLE_VALUE;
     }
+    if (hSocket != INVALID_SOCKET) {
+        closesocket(hSocket);
+        hSocket = INVALID_SOCKET;
+        WSACleanup();
+    }
 }
 
 std::string SerialCommunication::sendMessage(const std::string& message) {
-    if (hSerial == INVALID_HANDLE_VALUE) {
+    if (!isConnected()) {
         std::cerr << "   ." << std::endl;
         return "";
     }
 
-    DWORD bytesWritten;
-    if (!WriteFile(hSerial, message.c_str(), message.size(), &bytesWritten, nullptr)) {
+    if (!writeBytes(message)) {
         std::cerr << "     ." << std::endl;
         return "";
     }
 
+    // A read ends when the buffer is full or the line is silent for 50 ms; a reply longer
+    // than the buffer or cut mid-line is read on, so its tail is not taken as the next reply
+    std::string response;
     char buffer[256];
     DWORD bytesRead;
-    if (!ReadFile(hSerial, buffer, sizeof(buffer) - 1, &bytesRead, nullptr)) {
-        std::cerr << "     ." << std::endl;
-        return "";
+    DWORD firstByteTimeout = 50 + 10 * sizeof(buffer);
+    do {
+        bool isRead = (hSocket != INVALID_SOCKET)
+            ? readSocket(buffer, sizeof(buffer), bytesRead, firstByteTimeout, 50)
+            : ReadFile(hSerial, buffer, sizeof(buffer), &bytesRead, nullptr);
+        if (!isRead) {
+            std::cerr << "     ." << std::endl;
+            return "";
+        }
+        response.append(buffer, bytesRead);
+        firstByteTimeout = 50;
+    } while (bytesRead > 0 && (bytesRead == sizeof(buffer) || response.back() != '\n'));
+
+    removeFlowControl(response);
+    return isMultiplexed ? demultiplex(response) : response;
+}
+
+bool SerialCommunication::enableChannels() {
+    if (hSerial == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    isMultiplexed = sendMessage("Channels On\n").find("Channels On") != std::string::npos;
+    return isMultiplexed;
+}
+
+// "#<channel> " prefix of a multiplexed line, -1 if there is none
+static int takeChannel(std::string& line) {
+    if (line.size() < 3 || line[0] != '#' || line[1] < '0' || line[1] > '9' || line[2] != ' ') {
+        return -1;
+    }
+    int channel = line[1] - '0';
+    line.erase(0, 3);
+    return channel;
+}
+
+// Strips the channel prefixes; the lines stay in channel order, then in arrival order
+std::string SerialCommunication::demultiplex(const std::string& data) const {
+    std::vector<std::pair<int, std::string>> lines;
+    size_t start = 0;
+    while (start < data.size()) {
+        size_t end = data.find('\n', start);
+        end = (end == std::string::npos) ? data.size() : end + 1;
+        std::string line = data.substr(start, end - start);
+        int channel = takeChannel(line);
+        lines.emplace_back(channel < 0 ? CHANNEL_RESPONSES : channel, line);
+        start = end;
     }
-    buffer[bytesRead] = '\0';
+    std::stable_sort(lines.begin(), lines.end(), [](const std::pair<int, std::string>& a, const std::pair<int, std::string>& b) {
+        return a.first < b.first;
+    });
 
-    return std::string(buffer);
+    std::string result;
+    for (const auto& line : lines) {
+        result += line.second;
+    }
+    return result;
+}
+
+bool SerialCommunication::sendCommand(const std::string& message) {
+    if (!isConnected()) {
+        return false;
+    }
+    return writeBytes(message);
+}
+
+// Next complete line of readBuffer without reading the port
+bool SerialCommunication::takeBufferedLine(std::string& line) {
+    size_t end = readBuffer.find('\n');
+    if (end == std::string::npos) {
+        return false;
+    }
+    line = readBuffer.substr(0, end);
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    readBuffer.erase(0, end + 1);
+    return true;
+}
+
+bool SerialCommunication::readLine(std::string& line) {
+    while (isReading) {
+        if (takeBufferedLine(line)) {
+            return true;
+        }
+
+        // Blocks until at least one byte arrives (or the wait timeout expires)
+        char buffer[256];
+        DWORD bytesRead = 0;
+        bool isRead = (hSocket != INVALID_SOCKET)
+            ? readSocket(buffer, sizeof(buffer), bytesRead, 500, 0)
+            : ReadFile(hSerial, buffer, sizeof(buffer), &bytesRead, nullptr);
+        if (!isRead) {
+            return false;
+        }
+        readBuffer.append(buffer, bytesRead);
+        removeFlowControl(readBuffer);
+    }
+    return false;
+}
+
+void SerialCommunication::startEventReader(EventHandler handler) {
+    if (!isConnected() || isReading) {
+        return;
+    }
+
+    // ReadFile returns as soon as any byte is received instead of waiting
+    // for the interval timeout, so events reach the renderer immediately
+    if (hSerial != INVALID_HANDLE_VALUE) {
+        COMMTIMEOUTS timeouts = { 0 };
+        timeouts.ReadIntervalTimeout = MAXDWORD;
+        timeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
+        timeouts.ReadTotalTimeoutConstant = 500;
+        SetCommTimeouts(hSerial, &timeouts);
+    }
+
+    isReading = true;
+    // Lines that arrived together are handled game events first, telemetry last
+    eventReader = std::thread([this, handler]() {
+        std::string line;
+        GameEvent event;
+        while (readLine(line)) {
+            std::vector<std::pair<int, std::string>> lines;
+            do {
+                int channel = isMultiplexed ? takeChannel(line) : -1;
+                lines.emplace_back(channel < 0 ? CHANNEL_RESPONSES : channel, line);
+            } while (takeBufferedLine(line));
+            std::stable_sort(lines.begin(), lines.end(), [](const std::pair<int, std::string>& a, const std::pair<int, std::string>& b) {
+                return a.first < b.first;
+            });
+            for (const auto& received : lines) {
+                if (parseGameEvent(received.second, event)) {
+                    handler(event);
+                }
+            }
+        }
+    });
+}
+
+void SerialCommunication::stopEventReader() {
+    if (!isReading) {
+        return;
+    }
+    isReading = false;
+    if (eventReader.joinable()) {
+        eventReader.join();
+    }
+    readBuffer.clear();
+
+    if (hSerial != INVALID_HANDLE_VALUE) {
+        COMMTIMEOUTS timeouts = { 0 };
+        timeouts.ReadIntervalTimeout = 50;
+        timeouts.ReadTotalTimeoutConstant = 50;
+        timeouts.ReadTotalTimeoutMultiplier = 10;
+        timeouts.WriteTotalTimeoutConstant = 50;
+        timeouts.WriteTotalTimeoutMultiplier = 10;
+        SetCommTimeouts(hSerial, &timeouts);
+    }
+}
+
+bool parseGameEvent(const std::string& line, GameEvent& event) {
+    if (line.rfind("Event ", 0) != 0 && line.rfind("Telemetry nodes=", 0) != 0 && line.rfind("Stats ", 0) != 0) {
+        return false;
+    }
+
+    event = GameEvent();
+    if (line.rfind("Telemetry nodes=", 0) == 0) {
+        event.type = "Telemetry";
+        event.result = line;
+        return true;
+    }
+    if (line.rfind("Stats ", 0) == 0) {
+        event.type = "Stats";
+        event.result = line;
+        return true;
+    }
+    if (line.rfind("Event Move ", 0) == 0) {
+        // Event Move X 5 1234X6789
+        if (line.size() < 13) {
+            return false;
+        }
+        event.type = "Move";
+        event.player = line[11];
+        size_t boardPos = line.find(' ', 13);
+        if (boardPos == std::string::npos) {
+            return false;
+        }
+        event.position = std::atoi(line.substr(13, boardPos - 13).c_str());
+        event.boardState = line.substr(boardPos + 1);
+        return event.boardState.size() >= 9;
+    }
+    if (line.rfind("Event Result ", 0) == 0) {
+        event.type = "Result";
+        event.result = line.substr(13);
+        return true;
+    }
+    return false;
+}
+
+void TelemetrySummary::add(const std::string& response) {
+    for (size_t start = response.find("Telemetry nodes="); start != std::string::npos; start = response.find("Telemetry nodes=", start + 1)) {
+        std::string line = response.substr(start, response.find('\n', start) - start);
+        unsigned long long values[5] = { 0 };
+        if (sscanf(line.c_str(), "Telemetry nodes=%llu cutoffs=%llu ttHits=%llu depth=%llu us=%llu",
+                   &values[0], &values[1], &values[2], &values[3], &values[4]) != 5) {
+            continue;
+        }
+        moves++;
+        nodes += values[0];
+        cutoffs += values[1];
+        ttHits += values[2];
+        maxDepth = (std::max)(maxDepth, (int)values[3]);
+        microseconds += values[4];
+    }
+}
+
+void TelemetrySummary::print() const {
+    if (moves == 0) {
+        return;
+    }
+    std::cout << "AI telemetry: " << moves << " moves, " << nodes << " nodes (" << nodes / moves << " per move), "
+              << cutoffs << " cutoffs, " << ttHits << " table hits, max depth " << maxDepth << ", "
+              << microseconds / moves << " us per move" << std::endl;
 }
 
 void SerialCommunication::drawBoard(const std::string& boardState) {
@@ -108,6 +453,12 @@ void loadConfig(const std::string& filename) {
         file >> j;  
         port = j["Connection"]["port"].get<std::string>();
         baudRate = j["Connection"]["baudRate"].get<int>();
+        if (j.contains("SolvedGames")) {
+            solvedGamesPath = j["SolvedGames"].value("file", "");
+        }
+        if (j.contains("Stats")) {
+            statsPollSeconds = j["Stats"].value("pollSeconds", 0);
+        }
 
         if (port.empty() || baudRate == 0) {
             std::cerr << "Problem reading settings. Verify that the file has the correct format and value." << std::endl;
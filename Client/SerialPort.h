@@ -1,19 +1,88 @@
 #ifndef SERIALPORT_H
 #define SERIALPORT_H
+#include <atomic>
 #include <fstream> 
+#include <functional>
 #include <string>
+#include <thread>
+#include <winsock2.h> // Winsock must be included before windows.h
 #include <windows.h> //   Windows API
 
 extern std::string port;
 extern int baudRate;
+extern std::string solvedGamesPath; // Optional, written by solve_games
+extern int statsPollSeconds; // Optional, 0 - the client does not poll "Stats"
 
+// Software flow control of the sketch's receive ring
+const char XON_CHAR = 0x11;
+const char XOFF_CHAR = 0x13;
+
+// "Channels On" makes the sketch start every line with "#<channel> " and send the lines
+// of a reply in channel order; the client keeps that order when it hands lines on
+enum Channel {
+    CHANNEL_EVENTS,
+    CHANNEL_RESPONSES,
+    CHANNEL_TELEMETRY
+};
+
+// Event pushed by the server after "Subscribe":
+//   Event Move <player> <position> <board>
+//   Event Result <X Wins|O Wins|Draw>
+// and after every AI move once "Telemetry On" is set, with the whole line in result:
+//   Telemetry nodes=<n> cutoffs=<n> ttHits=<n> depth=<plies> us=<microseconds>
+// and the reply to a "Stats" poll, also with the whole line in result:
+//   Stats free=<bytes> minFree=<bytes> loopMaxUs=<us> rxMax=<bytes> rxDropped=<bytes> tx=<bytes> txMaxUs=<us> commands=<n> invalid=<n>
+struct GameEvent {
+    std::string type;
+    char player = ' ';
+    int position = 0;
+    std::string boardState;
+    std::string result;
+};
+
+bool parseGameEvent(const std::string& line, GameEvent& event);
+
+// Sums of the Telemetry lines over a session
+struct TelemetrySummary {
+    uint64_t moves = 0;
+    uint64_t nodes = 0;
+    uint64_t cutoffs = 0;
+    uint64_t ttHits = 0;
+    uint64_t microseconds = 0;
+    int maxDepth = 0;
+
+    void add(const std::string& response); // Every Telemetry line of a reply
+    void print() const;
+};
+
+// Talks to the Arduino over a COM port ("COM5") or to the host server
+// over TCP ("tcp://127.0.0.1:5555") with the same command protocol
 class SerialCommunication {
 private:
     HANDLE hSerial = INVALID_HANDLE_VALUE;
+    SOCKET hSocket = INVALID_SOCKET;
+    std::string readBuffer;
+    std::thread eventReader;
+    std::atomic<bool> isReading{ false };
+    bool isMultiplexed = false;
+
+    bool connectSocket(const std::string& address);
+    bool isConnected() const;
+    bool writeBytes(const std::string& message);
+    bool readSocket(char* buffer, DWORD size, DWORD& bytesRead, DWORD firstByteTimeout, DWORD intervalTimeout);
+    bool readLine(std::string& line);
+    bool takeBufferedLine(std::string& line);
+    std::string demultiplex(const std::string& data) const;
 
 public:
+    using EventHandler = std::function<void(const GameEvent&)>;
+
     bool connect(const std::string& port, int baudRate);
+    bool enableChannels(); // COM ports only, a TCP connection carries a single client
     std::string sendMessage(const std::string& message);
+    bool sendCommand(const std::string& message);
+    void startEventReader(EventHandler handler);
+    void stopEventReader();
     void disconnect();
     void drawBoard(const std::string& boardState);
 };
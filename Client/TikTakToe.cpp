@@ -1,5 +1,73 @@
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <sstream>
 #include "SerialPort.h"
+#include "..\Host\SolvedGameFile.h"
+
+// "BoardState: X2O456789" -> perfect-play value and best move from the solved games file
+static void printPerfectPlay(const SolvedGameFile& solvedGames, const std::string& response)
+{
+    if (response.find("BoardState: ") != 0 || response.size() < 21)
+    {
+        return;
+    }
+    std::string boardState = response.substr(12, 9);
+    uint64_t index = 0;
+    int xCount = 0;
+    int oCount = 0;
+    for (int k = 8; k >= 0; k--)
+    {
+        char cell = boardState[k];
+        index = index * 3 + (cell == 'X' ? 1 : cell == 'O' ? 2 : 0);
+        xCount += (cell == 'X');
+        oCount += (cell == 'O');
+    }
+
+    SolvedGameFile::Entry entry = solvedGames.lookup(index);
+    char player = (xCount == oCount) ? 'X' : 'O';
+    if (entry.value == SolvedGameFile::VALUE_DRAW)
+    {
+        std::cout << "Perfect play: draw";
+    }
+    else if (entry.value != SolvedGameFile::VALUE_UNKNOWN)
+    {
+        char winner = (entry.value == SolvedGameFile::VALUE_WIN) ? player : (player == 'X' ? 'O' : 'X');
+        std::cout << "Perfect play: " << winner << " wins";
+    }
+    else
+    {
+        return;
+    }
+    if (entry.bestMove >= 0)
+    {
+        std::cout << ", best move for " << player << ": " << entry.bestMove + 1;
+    }
+    std::cout << std::endl;
+}
+
+// "Analysis O . 0 -9 ..." -> board of move scores for the side to move, "." for occupied cells
+static void printAnalysis(const std::string& response)
+{
+    if (response.find("Analysis ") != 0 || response.size() < 11 || response.compare(9, 8, "GameOver") == 0)
+    {
+        return;
+    }
+    std::istringstream scores(response.substr(11));
+    std::cout << "Move scores for " << response[9] << " (positive - winning, 0 - draw):" << std::endl;
+    for (int i = 0; i < 3; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            std::string score;
+            scores >> score;
+            std::cout << std::setw(5) << score;
+        }
+        std::cout << std::endl;
+    }
+}
 
 int main()
 {
@@ -10,6 +78,11 @@ int main()
         std::cout << "Configuration loaded: Port = " << port << ", BaudRate = " << baudRate << std::endl;
 
         SerialCommunication serial;
+        SolvedGameFile solvedGames;
+        if (!solvedGamesPath.empty() && solvedGames.open(solvedGamesPath))
+        {
+            std::cout << "Solved games loaded: " << solvedGamesPath << std::endl;
+        }
 
         if (!serial.connect(port, baudRate))
         {
@@ -18,6 +91,9 @@ int main()
         }
 
 
+        // Game events overtake board art and telemetry on the shared COM port
+        serial.enableChannels();
+
         std::cout << "Welcome to the game of Tic-Tac-Toe!" << std::endl;
         std::string response = serial.sendMessage("StartGame\n");
 
@@ -28,46 +104,109 @@ int main()
             std::cout << "Choose game mode (1 - Man vs Man, 2 - Man vs AI, 3 - AI vs AI): ";
             std::string mode;
             std::getline(std::cin, mode);
-            response = serial.sendMessage("SetMode " + mode + "\n");
-            std::cout << "Server response: " << response << std::endl;
+
+            // Counters of every AI move, summed up when the game ends
+            TelemetrySummary telemetry;
+            serial.sendMessage("Telemetry On\n");
 
             if (mode == "3")
             {
-                //        AI vs AI
-                while (true)
-                {
-                    response = serial.sendMessage("GetGameState\n");
+                // Server pushes every move and the result after "Subscribe",
+                // the reader thread renders them as they arrive
+                response = serial.sendMessage("Subscribe\n");
+                std::cout << "Server response: " << response << std::endl;
+
+                std::mutex gameOverMutex;
+                std::condition_variable gameOverSignal;
+                bool isGameOver = false;
 
-                    //   
-                    if (response.find("BoardState:") == 0)
+                serial.startEventReader([&](const GameEvent& event)
+                {
+                    if (event.type == "Move")
+                    {
+                        std::cout << "Move " << event.player << ": " << event.position << std::endl;
+                        serial.drawBoard(event.boardState);
+                    }
+                    else if (event.type == "Telemetry")
+                    {
+                        telemetry.add(event.result);
+                    }
+                    else if (event.type == "Stats")
+                    {
+                        std::cout << event.result << std::endl;
+                    }
+                    else if (event.type == "Result")
                     {
-                        std::string boardState = response.substr(12);
-                        serial.drawBoard(boardState);
+                        std::cout << event.result << std::endl;
+                        std::cout << "The game is over!" << std::endl;
+                        std::lock_guard<std::mutex> lock(gameOverMutex);
+                        isGameOver = true;
+                        gameOverSignal.notify_one();
                     }
+                });
 
-                    std::cout << response << std::endl;
+                serial.sendCommand("SetMode " + mode + "\n");
 
-                    // ,   
-                    if (response.find("Wins") != std::string::npos || response.find("Draw") != std::string::npos)
+                // The Stats reply arrives through the event reader between the moves
+                std::unique_lock<std::mutex> lock(gameOverMutex);
+                while (!gameOverSignal.wait_for(lock, std::chrono::seconds(statsPollSeconds > 0 ? statsPollSeconds : 3600), [&] { return isGameOver; }))
+                {
+                    if (statsPollSeconds > 0)
                     {
-                        std::cout << "The game is over!" << std::endl;
-                        break;
+                        serial.sendCommand("Stats\n");
+                    }
+                }
+                lock.unlock();
+                serial.disconnect();
+            }
+            else
+            {
+                response = serial.sendMessage("SetMode " + mode + "\n");
+                std::cout << "Server response: " << response << std::endl;
+
+                if (mode == "2")
+                {
+                    std::cout << "Choose difficulty (1 - easiest ... 5 - perfect play, Enter for 5): ";
+                    std::string level;
+                    std::getline(std::cin, level);
+                    if (!level.empty())
+                    {
+                        response = serial.sendMessage("SetLevel " + level + "\n");
+                        std::cout << "Server response: " << response << std::endl;
                     }
                 }
             }
 
             if (mode != "3")
             {
+                // Polled between the moves, so a reply never interleaves with a move
+                auto lastStatsPoll = std::chrono::steady_clock::now();
                 while (true)
                 {
+                    if (statsPollSeconds > 0 && std::chrono::steady_clock::now() - lastStatsPoll >= std::chrono::seconds(statsPollSeconds))
+                    {
+                        lastStatsPoll = std::chrono::steady_clock::now();
+                        std::cout << serial.sendMessage("Stats\n");
+                    }
+
                     std::string input;
-                    std::cout << "Enter your move (1-9) or 'exit' to exit: ";
+                    std::cout << "Enter your move (1-9), 'analyze' for move scores, 'stats' for server health or 'exit' to exit: ";
                     std::getline(std::cin, input);
 
                     if (input == "exit")
                     {
                         break;
                     }
+                    if (input == "analyze")
+                    {
+                        printAnalysis(serial.sendMessage("Analyze\n"));
+                        continue;
+                    }
+                    if (input == "stats")
+                    {
+                        std::cout << serial.sendMessage("Stats\n");
+                        continue;
+                    }
 
                     try
                     {
@@ -81,6 +220,7 @@ int main()
                         if (mode == "2") {
                             response = serial.sendMessage("Move " + input + "\n");
                             std::cout << "Server response: " << response << std::endl;
+                            telemetry.add(response);
                         }
                         else {
                             response = serial.sendMessage("Move " + input + "\n");
@@ -93,6 +233,11 @@ int main()
                             serial.drawBoard(boardState);
                         }
 
+                        if (solvedGames.isOpen())
+                        {
+                            printPerfectPlay(solvedGames, serial.sendMessage("GetGameState\n"));
+                        }
+
                         if (response.find("Wins") != std::string::npos || response.find("Draw") != std::string::npos)
                         {
                             std::cout << "The game is over!" << std::endl;
@@ -107,6 +252,7 @@ int main()
 
                 serial.disconnect();
             }
+            telemetry.print();
         }
     }
     catch (const std::exception& e)
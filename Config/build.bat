@@ -1,7 +1,7 @@
 @echo off
 
 REM Компіляція клієнтського додатку
-g++ -o ..\Build\main.exe ..\Client\TikTakToe.cpp ..\Client\SerialPort.cpp ..\Client\SerialPort.h
+g++ -o ..\Build\main.exe ..\Client\TikTakToe.cpp ..\Client\SerialPort.cpp ..\Client\SerialPort.h ..\Host\SolvedGameFile.cpp -lws2_32
 
 REM Компіляція Arduino програми через платформу Arduino (IDE або arduino-cli)
 arduino-cli compile --fqbn arduino:avr:uno ..\Server\server\server.ino
\ No newline at end of file
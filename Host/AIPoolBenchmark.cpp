@@ -0,0 +1,143 @@
+// Measures AI moves per second on the work-stealing pool for 1..N workers.
+// Every task is one bestMove() from a different opening position, like
+// concurrent Man vs AI games asking for the server's reply.
+// The second table is the latency of single searches from the empty board, sequential
+// bestMove() against rootParallelBestMove(), which must choose the same moves.
+// Last, tasks that submit subtasks from the workers check that waitIdle() waits for all
+// of them; the benchmark exits 1 if it returns early.
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "GameCore.h"
+#include "RootParallelSearch.h"
+#include "WorkStealingPool.h"
+
+// All positions after one X and one O move: 72 searches of ~7! nodes each
+static std::vector<uint32_t> openingPositions() {
+    std::vector<uint32_t> positions;
+    for (int x = 0; x < CELL_COUNT; x++) {
+        for (int o = 0; o < CELL_COUNT; o++) {
+            if (x != o) {
+                positions.push_back(withCell(withCell(EMPTY_BOARD, x, CELL_X), o, CELL_O));
+            }
+        }
+    }
+    return positions;
+}
+
+const int NESTED_TASKS = 64;
+
+// Every task submits NESTED_TASKS subtasks from its worker, as the root split does
+static bool waitsForNestedTasks(unsigned workers, int rounds) {
+    WorkStealingPool pool(workers);
+    for (int round = 0; round < rounds; round++) {
+        std::atomic<int> done{ 0 };
+        for (int i = 0; i < NESTED_TASKS; i++) {
+            pool.submit([&pool, &done]() {
+                for (int j = 0; j < NESTED_TASKS; j++) {
+                    pool.submit([&done]() { done++; });
+                }
+                done++;
+            });
+        }
+        pool.waitIdle();
+        if (done.load() != NESTED_TASKS * (NESTED_TASKS + 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    unsigned maxWorkers = std::thread::hardware_concurrency();
+    int rounds = 20;
+    if (argc > 1) {
+        maxWorkers = static_cast<unsigned>(atoi(argv[1]));
+    }
+    if (argc > 2) {
+        rounds = atoi(argv[2]);
+    }
+    if (maxWorkers == 0) {
+        maxWorkers = 1;
+    }
+
+    std::vector<uint32_t> positions = openingPositions();
+    double singleWorkerRate = 0;
+
+    std::cout << "workers  moves/s     speedup  efficiency  steals  maxQueued" << std::endl;
+    for (unsigned workers = 1; workers <= maxWorkers; workers++) {
+        WorkStealingPool pool(workers);
+        std::atomic<int> checksum{ 0 };
+
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; round++) {
+            for (uint32_t cells : positions) {
+                pool.submit([cells, &checksum]() {
+                    int move[2];
+                    bestMove(cells, PLAYER_X, move);
+                    checksum += move[0] * BOARD_SIZE + move[1];
+                });
+            }
+        }
+        pool.waitIdle();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        double rate = rounds * positions.size() / seconds;
+        if (workers == 1) {
+            singleWorkerRate = rate;
+        }
+        WorkStealingPool::Metrics metrics = pool.metrics();
+        double speedup = rate / singleWorkerRate;
+        std::cout << std::setw(7) << workers << "  "
+                  << std::setw(10) << std::fixed << std::setprecision(0) << rate << "  "
+                  << std::setw(7) << std::setprecision(2) << speedup << "  "
+                  << std::setw(9) << std::setprecision(0) << 100.0 * speedup / workers << "%  "
+                  << std::setw(6) << metrics.steals << "  "
+                  << std::setw(9) << metrics.maxQueueDepth << std::endl;
+    }
+
+    // The empty board and every first move: the deepest searches the server runs
+    std::vector<uint32_t> searches(1, EMPTY_BOARD);
+    for (int k = 0; k < CELL_COUNT; k++) {
+        searches.push_back(withCell(EMPTY_BOARD, k, CELL_X));
+    }
+    auto timeSearches = [&](RootSearch mode, WorkStealingPool* pool, std::vector<int>& moves) {
+        moves.clear();
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t cells : searches) {
+            int move[2];
+            searchBestMove(mode, pool, cells, sideToMove(cells), move);
+            moves.push_back(move[0] * BOARD_SIZE + move[1]);
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / searches.size();
+    };
+
+    std::vector<int> sequentialMoves;
+    std::vector<int> parallelMoves;
+    double sequentialLatency = timeSearches(RootSearch::Sequential, nullptr, sequentialMoves);
+    std::cout << std::endl << "root split  ms/search  speedup  same moves" << std::endl;
+    std::cout << " sequential  " << std::setw(9) << std::setprecision(2) << sequentialLatency << "     1.00  yes" << std::endl;
+    for (unsigned workers = 1; workers <= maxWorkers; workers++) {
+        WorkStealingPool pool(workers);
+        double latency = timeSearches(RootSearch::Parallel, &pool, parallelMoves);
+        std::cout << std::setw(11) << workers << "  "
+                  << std::setw(9) << latency << "  "
+                  << std::setw(7) << sequentialLatency / latency << "  "
+                  << (parallelMoves == sequentialMoves ? "yes" : "NO") << std::endl;
+    }
+
+    bool isComplete = true;
+    std::cout << std::endl << "nested submits  waitIdle" << std::endl;
+    for (unsigned workers = 1; workers <= maxWorkers; workers++) {
+        bool isWorkerComplete = waitsForNestedTasks(workers, rounds * 50);
+        std::cout << std::setw(14) << workers << "  " << (isWorkerComplete ? "complete" : "EARLY") << std::endl;
+        isComplete = isComplete && isWorkerComplete;
+    }
+    return isComplete ? 0 : 1;
+}
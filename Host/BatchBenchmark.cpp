@@ -0,0 +1,108 @@
+// Boards per second for win/draw/legal-move detection on 3x3 boards: checkWin() and
+// isBoardFull() from GameCore.h one board at a time, against the BatchEvaluator kernels
+// over a structure-of-arrays batch. Every kernel must agree with checkWin() on every board.
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "BoardBatch.h"
+#include "GameCore.h"
+
+// Random games cut off after a random number of moves, finished games included
+static std::vector<uint32_t> randomPositions(size_t count) {
+    std::mt19937 random(12345);
+    std::vector<uint32_t> positions;
+    while (positions.size() < count) {
+        uint32_t cells = EMPTY_BOARD;
+        int moves = random() % (CELL_COUNT + 1);
+        for (int k = 0; k < moves && !isGameOver(cells); k++) {
+            int cell;
+            do {
+                cell = random() % CELL_COUNT;
+            } while (cellAt(cells, cell) != CELL_EMPTY);
+            cells = withCell(cells, cell, pieceOf(sideToMove(cells)));
+        }
+        positions.push_back(cells);
+    }
+    return positions;
+}
+
+static void evaluateWithCheckWin(const std::vector<uint32_t>& positions, BatchResult& result) {
+    result.status.resize(positions.size());
+    result.legalMoves.resize(positions.size());
+    for (size_t k = 0; k < positions.size(); k++) {
+        uint32_t cells = positions[k];
+        uint16_t flags = (checkWin(cells, PLAYER_X) ? BATCH_X_WINS : 0) | (checkWin(cells, PLAYER_O) ? BATCH_O_WINS : 0);
+        if (flags == 0 && isBoardFull(cells)) {
+            flags = BATCH_DRAW;
+        }
+        uint16_t moves = 0;
+        for (int cell = 0; flags == 0 && cell < CELL_COUNT; cell++) {
+            if (cellAt(cells, cell) == CELL_EMPTY) {
+                moves |= 1 << cell;
+            }
+        }
+        result.status[k] = flags;
+        result.legalMoves[k] = moves;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t boards = (argc > 1) ? static_cast<size_t>(atol(argv[1])) : 1 << 20;
+    int rounds = (argc > 2) ? atoi(argv[2]) : 20;
+    if (boards == 0 || rounds <= 0) {
+        std::cout << "Usage: " << argv[0] << " [boards] [rounds]" << std::endl;
+        return 1;
+    }
+
+    std::vector<uint32_t> positions = randomPositions(boards);
+    BoardBatch batch;
+    for (uint32_t cells : positions) {
+        uint16_t x = 0;
+        uint16_t o = 0;
+        for (int cell = 0; cell < CELL_COUNT; cell++) {
+            x |= (cellAt(cells, cell) == CELL_X) << cell;
+            o |= (cellAt(cells, cell) == CELL_O) << cell;
+        }
+        batch.add(x, o);
+    }
+
+    BatchResult expected;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        evaluateWithCheckWin(positions, expected);
+    }
+    double baseline = boards * rounds / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << boards << " boards x " << rounds << " rounds" << std::endl;
+    std::cout << "method     boards/s      speedup  mismatches" << std::endl;
+    std::cout << std::setw(9) << std::left << "checkWin" << std::right << "  " << std::setw(12) << std::fixed << std::setprecision(0) << baseline
+              << "  " << std::setw(7) << std::setprecision(2) << 1.0 << "  " << std::setw(10) << 0 << std::endl;
+
+    GridGame game(BOARD_SIZE, BOARD_SIZE);
+    BatchEvaluator evaluator(game);
+    for (BatchKernel kernel : { BatchKernel::Scalar, BatchKernel::Sse41, BatchKernel::Avx2 }) {
+        if (!BatchEvaluator::isSupported(kernel)) {
+            std::cout << std::setw(9) << std::left << BatchEvaluator::kernelName(kernel) << std::right << "  not supported by this CPU" << std::endl;
+            continue;
+        }
+        BatchResult result;
+        start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; round++) {
+            evaluator.evaluate(batch, result, kernel);
+        }
+        double rate = boards * rounds / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        size_t mismatches = 0;
+        for (size_t k = 0; k < boards; k++) {
+            mismatches += (result.status[k] != expected.status[k] || result.legalMoves[k] != expected.legalMoves[k]);
+        }
+        std::cout << std::setw(9) << std::left << BatchEvaluator::kernelName(kernel) << std::right << "  " << std::setw(12) << std::setprecision(0) << rate
+                  << "  " << std::setw(7) << std::setprecision(2) << rate / baseline << "  " << std::setw(10) << mismatches << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "BlockTablebaseFile.h"
+
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+BlockTablebaseFile::~BlockTablebaseFile() {
+    close();
+}
+
+// The header, the whole offset table and the end of the last block must be inside the file
+static bool isHeaderValid(const BlockTablebaseHeader* header, size_t size) {
+    if (size < sizeof(BlockTablebaseHeader)
+        || memcmp(header->magic, "TTTC", 4) != 0
+        || header->version != BLOCK_TABLEBASE_VERSION
+        || header->blockShift > 30
+        || header->blockCount != (static_cast<uint64_t>(header->entryCount) + (1ull << header->blockShift) - 1) >> header->blockShift) {
+        return false;
+    }
+    uint64_t indexBytes = 4ull * (header->blockCount + 1);
+    if (size - sizeof(BlockTablebaseHeader) < indexBytes) {
+        return false;
+    }
+    const uint8_t* offsets = reinterpret_cast<const uint8_t*>(header + 1);
+    uint32_t dataBytes = readTablebaseWord(offsets + 4 * header->blockCount) & ~BLOCK_RLE_FLAG;
+    return size - sizeof(BlockTablebaseHeader) - indexBytes >= dataBytes;
+}
+
+bool BlockTablebaseFile::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Failed to open tablebase: " << path << std::endl;
+        return false;
+    }
+    struct stat status;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &status) == 0 && status.st_size > 0) {
+        view = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (view == MAP_FAILED || !isHeaderValid(static_cast<const BlockTablebaseHeader*>(view), status.st_size)) {
+        std::cerr << "Invalid tablebase: " << path << std::endl;
+        if (view != MAP_FAILED) {
+            munmap(view, status.st_size);
+        }
+        return false;
+    }
+    // Probes jump between blocks, read-ahead would only pull in unused pages
+    madvise(view, status.st_size, MADV_RANDOM);
+
+    mappedBytes = status.st_size;
+    header = static_cast<const BlockTablebaseHeader*>(view);
+    return true;
+}
+
+void BlockTablebaseFile::close() {
+    if (header) {
+        munmap(const_cast<BlockTablebaseHeader*>(header), mappedBytes);
+    }
+    header = nullptr;
+    mappedBytes = 0;
+}
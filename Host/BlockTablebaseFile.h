@@ -0,0 +1,37 @@
+#ifndef BLOCK_TABLEBASE_FILE_H
+#define BLOCK_TABLEBASE_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "BlockTablebase.h"
+
+// Compressed tablebase (tablebase_compress) mapped read-only for the search.
+// Only the header and the block index are checked; a probe pages in one block
+class BlockTablebaseFile {
+public:
+    BlockTablebaseFile() = default;
+    ~BlockTablebaseFile();
+
+    BlockTablebaseFile(const BlockTablebaseFile&) = delete;
+    BlockTablebaseFile& operator=(const BlockTablebaseFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return header != nullptr; }
+    int boardSize() const { return header ? header->boardSize : 0; }
+    int winLength() const { return header ? header->winLength : 0; }
+
+    // Legal positions only, see BlockTablebase.h
+    uint8_t probe(uint64_t index) const {
+        return probeBlockTablebase(reinterpret_cast<const uint8_t*>(header), static_cast<uint32_t>(index));
+    }
+
+private:
+    const BlockTablebaseHeader* header = nullptr;
+    size_t mappedBytes = 0;
+};
+
+#endif
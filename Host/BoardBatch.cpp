@@ -0,0 +1,138 @@
+#include "BoardBatch.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAS_X86_KERNELS 1
+#endif
+
+BatchEvaluator::BatchEvaluator(const GridGame& game) : allCells(static_cast<uint16_t>(game.cellMask())) {
+    for (uint64_t line : game.lines()) {
+        lines.push_back(static_cast<uint16_t>(line));
+    }
+}
+
+static void evaluateScalar(const uint16_t* x, const uint16_t* o, uint16_t* status, uint16_t* moves,
+                           size_t first, size_t count, const std::vector<uint16_t>& lines, uint16_t allCells) {
+    for (size_t k = first; k < count; k++) {
+        uint16_t flags = 0;
+        for (uint16_t line : lines) {
+            flags |= ((x[k] & line) == line) ? BATCH_X_WINS : 0;
+            flags |= ((o[k] & line) == line) ? BATCH_O_WINS : 0;
+        }
+        uint16_t empty = allCells & ~(x[k] | o[k]);
+        if (flags == 0 && empty == 0) {
+            flags = BATCH_DRAW;
+        }
+        status[k] = flags;
+        moves[k] = flags ? 0 : empty;
+    }
+}
+
+#ifdef HAS_X86_KERNELS
+
+// Lanes are all ones where a line is complete, the flags are masked out of them
+__attribute__((target("avx2")))
+static size_t evaluateAvx2(const uint16_t* x, const uint16_t* o, uint16_t* status, uint16_t* moves,
+                           size_t count, const std::vector<uint16_t>& lines, uint16_t allCells) {
+    const __m256i cellMask = _mm256_set1_epi16(static_cast<short>(allCells));
+    const __m256i zero = _mm256_setzero_si256();
+    size_t k = 0;
+    for (; k + 16 <= count; k += 16) {
+        __m256i xs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + k));
+        __m256i os = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o + k));
+        __m256i xWins = zero;
+        __m256i oWins = zero;
+        for (uint16_t line : lines) {
+            __m256i mask = _mm256_set1_epi16(static_cast<short>(line));
+            xWins = _mm256_or_si256(xWins, _mm256_cmpeq_epi16(_mm256_and_si256(xs, mask), mask));
+            oWins = _mm256_or_si256(oWins, _mm256_cmpeq_epi16(_mm256_and_si256(os, mask), mask));
+        }
+        __m256i empty = _mm256_andnot_si256(_mm256_or_si256(xs, os), cellMask);
+        __m256i wins = _mm256_or_si256(xWins, oWins);
+        __m256i draws = _mm256_andnot_si256(wins, _mm256_cmpeq_epi16(empty, zero));
+        __m256i flags = _mm256_or_si256(_mm256_or_si256(
+            _mm256_and_si256(xWins, _mm256_set1_epi16(BATCH_X_WINS)),
+            _mm256_and_si256(oWins, _mm256_set1_epi16(BATCH_O_WINS))),
+            _mm256_and_si256(draws, _mm256_set1_epi16(BATCH_DRAW)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(status + k), flags);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(moves + k), _mm256_andnot_si256(wins, empty));
+    }
+    return k;
+}
+
+__attribute__((target("sse4.1")))
+static size_t evaluateSse41(const uint16_t* x, const uint16_t* o, uint16_t* status, uint16_t* moves,
+                            size_t count, const std::vector<uint16_t>& lines, uint16_t allCells) {
+    const __m128i cellMask = _mm_set1_epi16(static_cast<short>(allCells));
+    const __m128i zero = _mm_setzero_si128();
+    size_t k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m128i xs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + k));
+        __m128i os = _mm_loadu_si128(reinterpret_cast<const __m128i*>(o + k));
+        __m128i xWins = zero;
+        __m128i oWins = zero;
+        for (uint16_t line : lines) {
+            __m128i mask = _mm_set1_epi16(static_cast<short>(line));
+            xWins = _mm_or_si128(xWins, _mm_cmpeq_epi16(_mm_and_si128(xs, mask), mask));
+            oWins = _mm_or_si128(oWins, _mm_cmpeq_epi16(_mm_and_si128(os, mask), mask));
+        }
+        __m128i empty = _mm_andnot_si128(_mm_or_si128(xs, os), cellMask);
+        __m128i wins = _mm_or_si128(xWins, oWins);
+        __m128i draws = _mm_andnot_si128(wins, _mm_cmpeq_epi16(empty, zero));
+        __m128i flags = _mm_or_si128(_mm_or_si128(
+            _mm_and_si128(xWins, _mm_set1_epi16(BATCH_X_WINS)),
+            _mm_and_si128(oWins, _mm_set1_epi16(BATCH_O_WINS))),
+            _mm_and_si128(draws, _mm_set1_epi16(BATCH_DRAW)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(status + k), flags);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(moves + k), _mm_andnot_si128(wins, empty));
+    }
+    return k;
+}
+
+#endif
+
+void BatchEvaluator::evaluate(const BoardBatch& batch, BatchResult& result, BatchKernel kernel) const {
+    size_t count = batch.size();
+    result.status.resize(count);
+    result.legalMoves.resize(count);
+    size_t done = 0;
+#ifdef HAS_X86_KERNELS
+    if (kernel == BatchKernel::Avx2 && isSupported(kernel)) {
+        done = evaluateAvx2(batch.x.data(), batch.o.data(), result.status.data(), result.legalMoves.data(), count, lines, allCells);
+    } else if (kernel == BatchKernel::Sse41 && isSupported(kernel)) {
+        done = evaluateSse41(batch.x.data(), batch.o.data(), result.status.data(), result.legalMoves.data(), count, lines, allCells);
+    }
+#endif
+    // The boards left over from the last full register
+    evaluateScalar(batch.x.data(), batch.o.data(), result.status.data(), result.legalMoves.data(), done, count, lines, allCells);
+}
+
+bool BatchEvaluator::isSupported(BatchKernel kernel) {
+#ifdef HAS_X86_KERNELS
+    if (kernel == BatchKernel::Avx2) {
+        return __builtin_cpu_supports("avx2");
+    }
+    if (kernel == BatchKernel::Sse41) {
+        return __builtin_cpu_supports("sse4.1");
+    }
+#endif
+    return kernel == BatchKernel::Scalar;
+}
+
+BatchKernel BatchEvaluator::bestKernel() {
+    if (isSupported(BatchKernel::Avx2)) {
+        return BatchKernel::Avx2;
+    }
+    return isSupported(BatchKernel::Sse41) ? BatchKernel::Sse41 : BatchKernel::Scalar;
+}
+
+const char* BatchEvaluator::kernelName(BatchKernel kernel) {
+    switch (kernel) {
+    case BatchKernel::Avx2:
+        return "AVX2";
+    case BatchKernel::Sse41:
+        return "SSE4.1";
+    default:
+        return "scalar";
+    }
+}
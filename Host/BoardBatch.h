@@ -0,0 +1,57 @@
+#ifndef BOARD_BATCH_H
+#define BOARD_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "GridBoard.h"
+
+// Many boards at once as a structure of arrays: one 16-bit bitboard per side and board,
+// so a 256-bit register holds the X (or O) marks of 16 boards. Boards up to 4x4.
+struct BoardBatch {
+    std::vector<uint16_t> x;
+    std::vector<uint16_t> o;
+
+    void add(uint16_t xCells, uint16_t oCells) {
+        x.push_back(xCells);
+        o.push_back(oCells);
+    }
+    size_t size() const { return x.size(); }
+};
+
+// Per-board results of BatchEvaluator::evaluate
+const uint16_t BATCH_X_WINS = 1;
+const uint16_t BATCH_O_WINS = 2;
+const uint16_t BATCH_DRAW = 4; // Full board without a line
+
+struct BatchResult {
+    std::vector<uint16_t> status;     // BATCH_* flags, 0 - game goes on
+    std::vector<uint16_t> legalMoves; // Empty cells, 0 once the game is over
+};
+
+enum class BatchKernel {
+    Scalar,
+    Sse41, // 8 boards per instruction
+    Avx2   // 16 boards per instruction
+};
+
+// Win, draw and legal-move masks for a whole batch. The SIMD kernels are compiled with
+// per-function target attributes and picked at run time, so the binary still runs on
+// CPUs without them; other architectures get the scalar loop only
+class BatchEvaluator {
+public:
+    explicit BatchEvaluator(const GridGame& game);
+
+    void evaluate(const BoardBatch& batch, BatchResult& result, BatchKernel kernel) const;
+
+    static bool isSupported(BatchKernel kernel);
+    static BatchKernel bestKernel();
+    static const char* kernelName(BatchKernel kernel);
+
+private:
+    std::vector<uint16_t> lines;
+    uint16_t allCells;
+};
+
+#endif
@@ -0,0 +1,446 @@
+// Depth-first proof-number search (df-pn) for N×N boards too large for the
+// retrograde solver, 5x5 with 4 in a row and up. The first pass proves or disproves
+// "the first player wins"; if that fails, a second pass tries "the second player
+// wins", and if both fail the game is a draw.
+// Proof and disproof numbers live in a fixed-size transposition table keyed by the
+// smallest of the eight symmetric Zobrist keys. When a bucket is full the entry with
+// the smallest searched subtree is replaced. The table is written to a checkpoint
+// file periodically, and a later run with the same file resumes from it.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "GridBoard.h"
+
+static const uint32_t INFINITE_NUMBER = 0x7FFFFFFF;
+
+static uint32_t saturatedSum(uint64_t a, uint64_t b) {
+    return static_cast<uint32_t>(std::min<uint64_t>(a + b, INFINITE_NUMBER));
+}
+
+static uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Proof and disproof numbers for the attacker, four entries per bucket
+class ProofTable {
+public:
+    struct Entry {
+        uint64_t key = 0;
+        uint32_t proof = 1;
+        uint32_t disproof = 1;
+        uint32_t work = 0; // Nodes searched below the entry, 0 - empty slot
+        uint32_t reserved = 0;
+    };
+
+    struct Bucket {
+        Entry entries[4];
+    };
+
+    explicit ProofTable(size_t megabytes) {
+        size_t count = 1;
+        while (count * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024) {
+            count *= 2;
+        }
+        buckets.resize(count);
+    }
+
+    bool lookup(uint64_t key, uint32_t& proof, uint32_t& disproof) const {
+        const Bucket& bucket = buckets[key & (buckets.size() - 1)];
+        for (const Entry& entry : bucket.entries) {
+            if (entry.work != 0 && entry.key == key) {
+                proof = entry.proof;
+                disproof = entry.disproof;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void store(uint64_t key, uint32_t proof, uint32_t disproof, uint64_t work) {
+        Bucket& bucket = buckets[key & (buckets.size() - 1)];
+        Entry* victim = &bucket.entries[0];
+        for (Entry& entry : bucket.entries) {
+            if (entry.work != 0 && entry.key == key) {
+                victim = &entry;
+                break;
+            }
+            if (entry.work < victim->work) {
+                victim = &entry;
+            }
+        }
+        if (victim->work == 0) {
+            used++;
+        } else if (victim->key != key) {
+            replacements++;
+        }
+        victim->key = key;
+        victim->proof = proof;
+        victim->disproof = disproof;
+        victim->work = static_cast<uint32_t>(std::min<uint64_t>(std::max<uint64_t>(work, 1), UINT32_MAX));
+    }
+
+    void clear() {
+        std::fill(buckets.begin(), buckets.end(), Bucket());
+        used = 0;
+    }
+
+    size_t sizeBytes() const { return buckets.size() * sizeof(Bucket); }
+    size_t capacity() const { return buckets.size() * 4; }
+    size_t usedEntries() const { return used; }
+    uint64_t replacementCount() const { return replacements; }
+
+    bool write(FILE* file) const {
+        return fwrite(buckets.data(), sizeof(Bucket), buckets.size(), file) == buckets.size();
+    }
+
+    bool read(FILE* file) {
+        if (fread(buckets.data(), sizeof(Bucket), buckets.size(), file) != buckets.size()) {
+            clear();
+            return false;
+        }
+        used = 0;
+        for (const Bucket& bucket : buckets) {
+            for (const Entry& entry : bucket.entries) {
+                used += (entry.work != 0);
+            }
+        }
+        return true;
+    }
+
+private:
+    std::vector<Bucket> buckets;
+    size_t used = 0;
+    uint64_t replacements = 0;
+};
+
+struct CheckpointHeader {
+    char magic[4];        // "TTPN"
+    uint8_t version;
+    uint8_t boardSize;
+    uint8_t winLength;
+    char attacker;        // 'O' - the first pass already showed that X does not win
+    uint64_t tableBytes;
+    uint64_t nodes;
+};
+
+const uint8_t CHECKPOINT_VERSION = 1;
+
+class DfpnSolver {
+public:
+    DfpnSolver(const GridGame& game, size_t hashMegabytes, const std::string& checkpointPath, double checkpointSeconds)
+        : game(game), table(hashMegabytes), checkpointPath(checkpointPath), checkpointSeconds(checkpointSeconds) {
+        uint64_t seed = 0xDF9;
+        for (int k = 0; k < 2 * game.cellCount(); k++) {
+            zobrist.push_back(splitMix64(seed));
+        }
+
+        // The eight rotations and reflections of the square
+        int size = game.size();
+        for (int symmetry = 0; symmetry < 8; symmetry++) {
+            for (int cell = 0; cell < game.cellCount(); cell++) {
+                int row = cell / size;
+                int column = cell % size;
+                if (symmetry & 1) {
+                    std::swap(row, column);
+                }
+                if (symmetry & 2) {
+                    row = size - 1 - row;
+                }
+                if (symmetry & 4) {
+                    column = size - 1 - column;
+                }
+                symmetricCells[symmetry][cell] = row * size + column;
+            }
+        }
+
+        for (int cell = 0; cell < game.cellCount(); cell++) {
+            moveOrder.push_back(cell);
+        }
+        auto distance = [size](int cell) {
+            int row = 2 * (cell / size) - (size - 1);
+            int column = 2 * (cell % size) - (size - 1);
+            return std::max(std::abs(row), std::abs(column)) * 2 + std::min(std::abs(row), std::abs(column));
+        };
+        std::stable_sort(moveOrder.begin(), moveOrder.end(), [&](int a, int b) { return distance(a) < distance(b); });
+    }
+
+    // 'X' - first player wins, 'O' - second player wins, 'D' - draw
+    char solve() {
+        char resumedAttacker = loadCheckpoint();
+        startTime = lastReport = lastCheckpoint = std::chrono::steady_clock::now();
+
+        if (resumedAttacker != 'O') {
+            if (prove('X')) {
+                return 'X';
+            }
+            table.clear();
+        }
+        return prove('O') ? 'O' : 'D';
+    }
+
+    uint64_t nodeCount() const { return nodes; }
+
+private:
+    struct Node {
+        GridPosition position;
+        uint64_t keys[8] = {};
+        int lastCell = -1;
+    };
+
+    const GridGame& game;
+    ProofTable table;
+    std::string checkpointPath;
+    double checkpointSeconds;
+    std::vector<uint64_t> zobrist;   // Two keys per cell, X and O
+    int symmetricCells[8][MAX_GRID_SIZE * MAX_GRID_SIZE];
+    std::vector<int> moveOrder;      // Centre cells first
+    char attacker = 'X';
+    uint64_t nodes = 0;
+    uint64_t proofs = 0;             // Nodes stored as proven
+    uint64_t disproofs = 0;
+    uint64_t lastProofs = 0;
+    uint64_t lastDisproofs = 0;
+    uint64_t lastNodes = 0;
+    std::chrono::steady_clock::time_point startTime, lastReport, lastCheckpoint;
+
+    bool prove(char side) {
+        attacker = side;
+        std::cout << "proving that " << side << " wins" << std::endl;
+        Node root;
+        uint32_t phi = 0;
+        uint32_t delta = 0;
+        search(root, INFINITE_NUMBER, INFINITE_NUMBER, phi, delta);
+        report();
+        saveCheckpoint();
+        // phi == 0 - the side to move at the root reaches its goal
+        return isAttackerToMove(root.position) == (phi == 0);
+    }
+
+    bool isAttackerToMove(const GridPosition& position) const {
+        return GridGame::isXToMove(position) == (attacker == 'X');
+    }
+
+    static uint64_t tableKey(const Node& node) {
+        return *std::min_element(node.keys, node.keys + 8);
+    }
+
+    Node child(const Node& node, int cell) const {
+        Node result;
+        int side = GridGame::isXToMove(node.position) ? 0 : 1;
+        result.position = GridGame::withMove(node.position, cell);
+        for (int symmetry = 0; symmetry < 8; symmetry++) {
+            result.keys[symmetry] = node.keys[symmetry] ^ zobrist[2 * symmetricCells[symmetry][cell] + side];
+        }
+        result.lastCell = cell;
+        return result;
+    }
+
+    // phi: cost of reaching the goal of the side to move (attacker wins for the attacker,
+    // attacker does not win for the defender), delta: cost of showing that it cannot.
+    // The table keeps the numbers from the attacker's view
+    void lookup(const Node& node, uint32_t& phi, uint32_t& delta) const {
+        bool isXToMove = GridGame::isXToMove(node.position);
+        uint64_t lastMover = isXToMove ? node.position.o : node.position.x;
+        if (node.lastCell >= 0 && game.isWinThrough(lastMover, node.lastCell)) {
+            phi = INFINITE_NUMBER; // Whoever just won, the side to move has lost its goal
+            delta = 0;
+            return;
+        }
+        if (game.isFull(node.position)) {
+            bool isAttacker = isAttackerToMove(node.position);
+            phi = isAttacker ? INFINITE_NUMBER : 0; // A draw is the defender's goal
+            delta = isAttacker ? 0 : INFINITE_NUMBER;
+            return;
+        }
+        uint32_t proof = 1;
+        uint32_t disproof = 1;
+        table.lookup(tableKey(node), proof, disproof);
+        phi = isAttackerToMove(node.position) ? proof : disproof;
+        delta = isAttackerToMove(node.position) ? disproof : proof;
+    }
+
+    void store(const Node& node, uint32_t phi, uint32_t delta, uint64_t work) {
+        bool isAttacker = isAttackerToMove(node.position);
+        uint32_t proof = isAttacker ? phi : delta;
+        uint32_t disproof = isAttacker ? delta : phi;
+        proofs += (proof == 0);
+        disproofs += (disproof == 0);
+        table.store(tableKey(node), proof, disproof, work);
+    }
+
+    // Multiple iterative deepening with the 1 + 1/4 threshold trick
+    void search(const Node& node, uint32_t thresholdPhi, uint32_t thresholdDelta, uint32_t& phi, uint32_t& delta) {
+        uint64_t startNodes = nodes++;
+        if ((nodes & 0xFFFF) == 0) {
+            onProgress();
+        }
+
+        // Children are looked up once and then updated from the values their searches
+        // return, so siblings that evict each other from the table cannot undo progress
+        int cells[MAX_GRID_SIZE * MAX_GRID_SIZE];
+        uint32_t childPhis[MAX_GRID_SIZE * MAX_GRID_SIZE];
+        uint32_t childDeltas[MAX_GRID_SIZE * MAX_GRID_SIZE];
+        int count = 0;
+        uint64_t empty = game.emptyCells(node.position);
+        for (int cell : moveOrder) {
+            if (empty & (1ull << cell)) {
+                lookup(child(node, cell), childPhis[count], childDeltas[count]);
+                cells[count++] = cell;
+            }
+        }
+
+        while (true) {
+            // The node's phi is the smallest delta of its children, its delta their phi sum
+            phi = INFINITE_NUMBER;
+            delta = 0;
+            int best = -1;
+            uint32_t secondDelta = INFINITE_NUMBER;
+            for (int k = 0; k < count; k++) {
+                delta = saturatedSum(delta, childPhis[k]);
+                if (childDeltas[k] < phi) {
+                    secondDelta = phi;
+                    phi = childDeltas[k];
+                    best = k;
+                } else if (childDeltas[k] < secondDelta) {
+                    secondDelta = childDeltas[k];
+                }
+            }
+            if (phi >= thresholdPhi || delta >= thresholdDelta || phi == 0 || delta == 0) {
+                break;
+            }
+
+            uint32_t childThresholdPhi = (thresholdDelta == INFINITE_NUMBER) ? INFINITE_NUMBER
+                : saturatedSum(thresholdDelta - delta, childPhis[best]);
+            uint32_t childThresholdDelta = std::min<uint64_t>(thresholdPhi, saturatedSum(secondDelta, secondDelta / 4 + 1));
+            search(child(node, cells[best]), childThresholdPhi, childThresholdDelta, childPhis[best], childDeltas[best]);
+        }
+        store(node, phi, delta, nodes - startNodes);
+    }
+
+    void onProgress() {
+        auto now = std::chrono::steady_clock::now();
+        if (std::chrono::duration<double>(now - lastReport).count() >= 1.0) {
+            report();
+        }
+        if (!checkpointPath.empty() && std::chrono::duration<double>(now - lastCheckpoint).count() >= checkpointSeconds) {
+            saveCheckpoint();
+        }
+    }
+
+    void report() {
+        auto now = std::chrono::steady_clock::now();
+        double interval = std::max(1e-9, std::chrono::duration<double>(now - lastReport).count());
+        uint32_t proof, disproof;
+        rootNumbers(proof, disproof);
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << std::setw(7) << std::chrono::duration<double>(now - startTime).count() << " s  "
+                  << nodes << " nodes  " << std::setprecision(0) << (nodes - lastNodes) / interval << " nodes/s  "
+                  << "root pn " << proof << " dn " << disproof << "  "
+                  << (proofs - lastProofs) / interval << " proofs/s  " << (disproofs - lastDisproofs) / interval << " disproofs/s  "
+                  << "table " << std::setprecision(1) << 100.0 * table.usedEntries() / table.capacity() << "% of "
+                  << table.sizeBytes() / (1024 * 1024) << " MB, " << table.replacementCount() << " replaced  "
+                  << "peak memory " << usage.ru_maxrss / 1024 << " MB" << std::endl;
+        lastReport = now;
+        lastNodes = nodes;
+        lastProofs = proofs;
+        lastDisproofs = disproofs;
+    }
+
+    // The root entry is only stored when a pass ends, so its numbers come from its children
+    void rootNumbers(uint32_t& proof, uint32_t& disproof) const {
+        Node root;
+        uint32_t phi = INFINITE_NUMBER;
+        uint32_t delta = 0;
+        for (int cell = 0; cell < game.cellCount(); cell++) {
+            uint32_t childPhi, childDelta;
+            lookup(child(root, cell), childPhi, childDelta);
+            phi = std::min(phi, childDelta);
+            delta = saturatedSum(delta, childPhi);
+        }
+        proof = isAttackerToMove(root.position) ? phi : delta;
+        disproof = isAttackerToMove(root.position) ? delta : phi;
+    }
+
+    // Written to a temporary file and renamed, so a crash leaves the previous checkpoint
+    void saveCheckpoint() {
+        lastCheckpoint = std::chrono::steady_clock::now();
+        if (checkpointPath.empty()) {
+            return;
+        }
+        CheckpointHeader header = { { 'T', 'T', 'P', 'N' }, CHECKPOINT_VERSION,
+            static_cast<uint8_t>(game.size()), static_cast<uint8_t>(game.winLength()), attacker, table.sizeBytes(), nodes };
+        std::string temporaryPath = checkpointPath + ".tmp";
+        FILE* file = fopen(temporaryPath.c_str(), "wb");
+        bool isWritten = file && fwrite(&header, sizeof(header), 1, file) == 1 && table.write(file);
+        if (file) {
+            isWritten = (fclose(file) == 0) && isWritten;
+        }
+        if (!isWritten || rename(temporaryPath.c_str(), checkpointPath.c_str()) != 0) {
+            std::cerr << "Failed to write checkpoint " << checkpointPath << std::endl;
+        }
+    }
+
+    // Returns the attacker of the saved pass, 0 if there is nothing to resume
+    char loadCheckpoint() {
+        FILE* file = checkpointPath.empty() ? nullptr : fopen(checkpointPath.c_str(), "rb");
+        if (file == nullptr) {
+            return 0;
+        }
+        CheckpointHeader header;
+        bool isValid = fread(&header, sizeof(header), 1, file) == 1
+            && memcmp(header.magic, "TTPN", 4) == 0
+            && header.version == CHECKPOINT_VERSION
+            && header.boardSize == game.size()
+            && header.winLength == game.winLength()
+            && header.tableBytes == table.sizeBytes()
+            && table.read(file);
+        fclose(file);
+        if (!isValid) {
+            std::cerr << "Ignoring checkpoint " << checkpointPath << " of another board or table size" << std::endl;
+            return 0;
+        }
+        nodes = lastNodes = header.nodes;
+        std::cout << "resumed from " << checkpointPath << ": " << header.nodes << " nodes, "
+                  << table.usedEntries() << " table entries" << std::endl;
+        return header.attacker;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    int size = (argc > 1) ? atoi(argv[1]) : 5;
+    int winLength = (argc > 2) ? atoi(argv[2]) : 4;
+    size_t hashMegabytes = (argc > 3) ? static_cast<size_t>(atol(argv[3])) : 256;
+    std::string checkpointPath = (argc > 4) ? argv[4] : "";
+    double checkpointSeconds = (argc > 5) ? atof(argv[5]) : 300;
+    if (size < 2 || size > MAX_GRID_SIZE || winLength < 2 || winLength > size || hashMegabytes == 0) {
+        std::cout << "Usage: " << argv[0] << " [size 2..8] [win length] [table MB] [checkpoint file] [checkpoint seconds]" << std::endl;
+        return 1;
+    }
+
+    GridGame game(size, winLength);
+    auto start = std::chrono::steady_clock::now();
+    DfpnSolver solver(game, hashMegabytes, checkpointPath, checkpointSeconds);
+    char result = solver.solve();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << size << "x" << size << ", " << winLength << " in a row: "
+              << (result == 'X' ? "first player wins" : result == 'O' ? "second player wins" : "draw")
+              << ", " << solver.nodeCount() << " nodes in " << seconds << " s" << std::endl;
+    return 0;
+}
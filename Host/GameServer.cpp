@@ -0,0 +1,588 @@
+#include "GameServer.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "Engines.h"
+#include "Listeners.h"
+
+size_t GameServer::Connection::write(uint8_t c) {
+    output.push_back(static_cast<char>(c));
+    server->txBytes++;
+    return 1;
+}
+
+size_t GameServer::Connection::write(const uint8_t* buffer, size_t size) {
+    output.append(reinterpret_cast<const char*>(buffer), size);
+    server->txBytes += size;
+    return size;
+}
+
+GameServer::GameServer(int aiWorkers, IoBackend backend) : backend(backend) {
+    // Drives AI vs AI games, like the AI_VS_AI_MOVE_DELAY check in the sketch's loop()
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    itimerspec interval = {};
+    interval.it_interval.tv_sec = AI_VS_AI_MOVE_DELAY / 1000;
+    interval.it_interval.tv_nsec = (AI_VS_AI_MOVE_DELAY % 1000) * 1000000;
+    interval.it_value = interval.it_interval;
+    timerfd_settime(timerFd, 0, &interval, nullptr);
+
+    inboxFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (aiWorkers >= 0) {
+        aiPool.reset(new WorkStealingPool(static_cast<unsigned>(aiWorkers)));
+        completionFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        setAIMoveScheduler(&GameServer::scheduleAIMove);
+    }
+
+    if (backend == IoBackend::Uring && !initUring()) {
+        std::cerr << "io_uring is not available, falling back to epoll" << std::endl;
+        this->backend = IoBackend::Epoll;
+    }
+
+    if (this->backend == IoBackend::Epoll) {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u64 = eventData(EVENT_TIMER, 0);
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &event);
+        event.data.u64 = eventData(EVENT_INBOX, 0);
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, inboxFd, &event);
+        if (completionFd >= 0) {
+            event.data.u64 = eventData(EVENT_COMPLETION, 0);
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, completionFd, &event);
+        }
+    }
+}
+
+GameServer::~GameServer() {
+    aiPool.reset(); // Joins the workers before their results can no longer be delivered
+    for (auto& entry : connections) {
+        if (!entry.second->isClosed) {
+            close(entry.second->fd);
+        }
+    }
+    ring.reset(); // Cancels everything still in flight before the buffers go away
+    connections.clear();
+    for (int fd : listeners) {
+        close(fd);
+    }
+    for (const std::string& path : unixPaths) {
+        unlink(path.c_str());
+    }
+    if (ptySlaveFd >= 0) {
+        close(ptySlaveFd);
+    }
+    if (completionFd >= 0) {
+        close(completionFd);
+    }
+    IncomingConnection incoming;
+    while (inbox.pop(incoming)) {
+        close(incoming.fd);
+    }
+    close(inboxFd);
+    close(timerFd);
+    if (epollFd >= 0) {
+        close(epollFd);
+    }
+}
+
+bool GameServer::listenTcp(uint16_t port) {
+    int fd = openTcpListener(port);
+    return fd >= 0 && addListener(fd);
+}
+
+bool GameServer::listenUnix(const std::string& path) {
+    int fd = openUnixListener(path);
+    if (fd < 0) {
+        return false;
+    }
+    unixPaths.push_back(path);
+    return addListener(fd);
+}
+
+bool GameServer::addListener(int fd) {
+    listeners.push_back(fd);
+    if (backend == IoBackend::Uring) {
+        return armAccept(listeners.size() - 1);
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = eventData(EVENT_LISTENER, listeners.size() - 1);
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        std::cerr << "Failed to register listener: " << strerror(errno) << std::endl;
+        listeners.pop_back();
+        close(fd);
+        return false;
+    }
+    return true;
+}
+
+std::string GameServer::listenPty() {
+    int masterFd = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (masterFd < 0 || grantpt(masterFd) < 0 || unlockpt(masterFd) < 0) {
+        std::cerr << "Failed to open pseudo-terminal: " << strerror(errno) << std::endl;
+        if (masterFd >= 0) {
+            close(masterFd);
+        }
+        return "";
+    }
+    std::string slavePath = ptsname(masterFd);
+
+    // Raw mode: bytes pass through unchanged, exactly like the board's UART
+    ptySlaveFd = open(slavePath.c_str(), O_RDWR | O_NOCTTY | O_CLOEXEC);
+    termios settings;
+    if (ptySlaveFd >= 0 && tcgetattr(ptySlaveFd, &settings) == 0) {
+        cfmakeraw(&settings);
+        tcsetattr(ptySlaveFd, TCSANOW, &settings);
+    }
+
+    fcntl(masterFd, F_SETFL, fcntl(masterFd, F_GETFL) | O_NONBLOCK);
+    addConnection(masterFd, nextConnectionId++, false);
+    return slavePath;
+}
+
+void GameServer::run() {
+    if (backend == IoBackend::Uring) {
+        runUring();
+    } else {
+        runEpoll();
+    }
+}
+
+void GameServer::stop() {
+    isStopRequested = true;
+}
+
+bool GameServer::offerConnection(int fd, uint64_t gameId) {
+    if (!inbox.push(IncomingConnection{ fd, gameId })) {
+        return false;
+    }
+    uint64_t one = 1;
+    return write(inboxFd, &one, sizeof(one)) == sizeof(one);
+}
+
+void GameServer::onInbox() {
+    IncomingConnection incoming;
+    while (inbox.pop(incoming)) {
+        addConnection(incoming.fd, incoming.gameId, true);
+    }
+}
+
+void GameServer::addConnection(int fd, uint64_t id, bool isSocket) {
+    std::unique_ptr<Connection> connection(new Connection());
+    connection->server = this;
+    connection->fd = fd;
+    connection->id = id;
+    connection->isSocket = isSocket;
+    connection->session.isInUse = true;
+
+    if (backend == IoBackend::Uring) {
+        if (!armReceive(*connection)) {
+            close(fd);
+            return;
+        }
+    } else {
+        epoll_event event = {};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = eventData(EVENT_RECEIVE, id);
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            close(fd);
+            return;
+        }
+    }
+    connections[id] = std::move(connection);
+}
+
+GameServer::Connection* GameServer::findConnection(uint64_t id) {
+    auto found = connections.find(id);
+    if (found == connections.end() || found->second->isClosed) {
+        return nullptr;
+    }
+    return found->second.get();
+}
+
+void GameServer::onReceived(Connection& connection, const char* data, size_t size) {
+    connection.input.append(data, size);
+    if (connection.input.size() > MAX_PENDING_INPUT) {
+        std::cerr << "Too much pending input, closing connection " << connection.id << std::endl;
+        closeConnection(connection);
+        return;
+    }
+
+    processInput(connection);
+    if (!connection.session.isAIThinking && connection.input.size() > MAX_COMMAND_LENGTH) {
+        std::cerr << "Command too long, closing connection " << connection.id << std::endl;
+        closeConnection(connection);
+        return;
+    }
+    flush(connection);
+}
+
+// Every complete line is one command, exactly as the sketch reads them.
+// While an AI move is being computed the remaining lines wait in the buffer,
+// so pipelined commands still see the board after the AI has moved.
+void GameServer::processInput(Connection& connection) {
+    auto started = std::chrono::steady_clock::now();
+    if (connection.input.size() > worstInputBacklog) {
+        worstInputBacklog = connection.input.size();
+    }
+    size_t start = 0;
+    size_t end;
+    while (!connection.session.isAIThinking && (end = connection.input.find('\n', start)) != std::string::npos) {
+        std::string command = connection.input.substr(start, end - start);
+        if (!command.empty() && command.back() == '\r') {
+            command.pop_back();
+        }
+        start = end + 1;
+        commandCount++;
+
+        if (command == "PoolStats") {
+            WorkStealingPool::Metrics metrics = aiPool ? aiPool->metrics() : WorkStealingPool::Metrics();
+            connection.print("PoolStats workers=");
+            connection.print(aiPool ? aiPool->workerCount() : 0u);
+            connection.print(" queued=");
+            connection.print(static_cast<unsigned long>(metrics.queueDepth));
+            connection.print(" maxQueued=");
+            connection.print(static_cast<unsigned long>(metrics.maxQueueDepth));
+            connection.print(" executed=");
+            connection.print(static_cast<unsigned long>(metrics.executed));
+            connection.print(" steals=");
+            connection.println(static_cast<unsigned long>(metrics.steals));
+            continue;
+        }
+        if (command == "IoStats") {
+            writeIoStats(connection);
+            continue;
+        }
+        if (command == "PerfectPlay") {
+            writePerfectPlay(connection);
+            continue;
+        }
+        if (command == "Stats") {
+            writeStats(connection);
+            continue;
+        }
+        size_t replyStart = connection.output.size();
+        handleCommand(connection.session, command.c_str(), connection);
+        if (connection.output.compare(replyStart, 7, "Invalid") == 0) {
+            invalidCount++;
+        }
+    }
+    connection.input.erase(0, start);
+    uint64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started).count();
+    if (micros > worstInputMicros) {
+        worstInputMicros = micros;
+    }
+    trackAutoPlay(connection);
+}
+
+// IoStats backend=<epoll|uring> syscalls=<n> commands=<n>
+void GameServer::writeIoStats(Connection& connection) {
+    uint64_t syscalls = ioSyscalls + (ring ? ring->enterCalls() : 0);
+    connection.print("IoStats backend=");
+    connection.print(backend == IoBackend::Uring ? "uring" : "epoll");
+    connection.print(" syscalls=");
+    connection.print(static_cast<unsigned long>(syscalls));
+    connection.print(" commands=");
+    connection.println(static_cast<unsigned long>(commandCount));
+}
+
+// The sketch's Stats line for the client's health poll. The host has no SRAM figures, its
+// sockets drop nothing and its sends never block, so those fields are 0
+void GameServer::writeStats(Connection& connection) {
+    connection.print("Stats free=0 minFree=0 loopMaxUs=");
+    connection.print(static_cast<unsigned long>(worstInputMicros));
+    connection.print(" rxMax=");
+    connection.print(static_cast<unsigned long>(worstInputBacklog));
+    connection.print(" rxDropped=0 tx=");
+    connection.print(static_cast<unsigned long>(txBytes));
+    connection.print(" txMaxUs=0 commands=");
+    connection.print(static_cast<unsigned long>(commandCount));
+    connection.print(" invalid=");
+    connection.println(static_cast<unsigned long>(invalidCount));
+}
+
+bool GameServer::openSolvedGames(const std::string& path) {
+    if (!solvedGames.open(path)) {
+        return false;
+    }
+    if (solvedGames.boardSize() != BOARD_SIZE || solvedGames.winLength() != BOARD_SIZE) {
+        std::cerr << path << " is not a " << BOARD_SIZE << "x" << BOARD_SIZE << " solved games file" << std::endl;
+        solvedGames.close();
+        return false;
+    }
+    return true;
+}
+
+// PerfectPlay <X Wins|O Wins|Draw> <best position, 0 if the game is over>, or PerfectPlay Unknown
+void GameServer::writePerfectPlay(Connection& connection) {
+    uint32_t cells = connection.session.cells;
+    SolvedGameFile::Entry entry = solvedGames.lookup(positionIndex(cells));
+    char player = sideToMove(cells);
+    connection.print("PerfectPlay ");
+    if (entry.value == SolvedGameFile::VALUE_UNKNOWN) {
+        connection.println("Unknown");
+        return;
+    }
+    if (entry.value == SolvedGameFile::VALUE_DRAW) {
+        connection.print("Draw");
+    } else {
+        connection.print(entry.value == SolvedGameFile::VALUE_WIN ? player : opponent(player));
+        connection.print(" Wins");
+    }
+    connection.print(' ');
+    connection.println(entry.bestMove + 1);
+}
+
+void GameServer::trackAutoPlay(Connection& connection) {
+    if (connection.session.isAutoPlaying) {
+        autoPlaying.insert(connection.id);
+    } else {
+        autoPlaying.erase(connection.id);
+    }
+}
+
+// Runs on the event loop thread, called by the protocol when an AI move is needed
+bool GameServer::scheduleAIMove(GameSession& session, char player, Print& out) {
+    Connection* connection = dynamic_cast<Connection*>(&out);
+    if (connection == nullptr || !connection->server->aiPool) {
+        return false;
+    }
+
+    GameServer* server = connection->server;
+    uint64_t connectionId = connection->id;
+    uint32_t cells = session.cells;
+    uint8_t engine = (player == PLAYER_X) ? session.engineX : session.engineO; // SetEngine number + 1
+    uint16_t engineState = session.engineState;
+
+    server->aiPool->submit([server, connectionId, cells, player, engine, engineState]() {
+        AIMoveResult result = { connectionId, player, { -1, -1 }, MoveTelemetry(), engineState };
+        unsigned long start = micros();
+        if (engine != 0) {
+            chooseEngineMove(engine - 1, cells, player, result.engineState, result.move, &result.telemetry.counters);
+        } else {
+            searchBestMove(server->rootSearch, server->aiPool.get(), cells, player, result.move, &result.telemetry.counters);
+        }
+        result.telemetry.microseconds = micros() - start;
+        {
+            std::lock_guard<std::mutex> lock(server->completionMutex);
+            server->completions.push_back(result);
+        }
+        uint64_t one = 1;
+        if (write(server->completionFd, &one, sizeof(one)) < 0) {
+            std::cerr << "Failed to signal AI move completion" << std::endl;
+        }
+    });
+    return true;
+}
+
+void GameServer::onCompletions() {
+    std::vector<AIMoveResult> results;
+    {
+        std::lock_guard<std::mutex> lock(completionMutex);
+        results.swap(completions);
+    }
+
+    for (const AIMoveResult& result : results) {
+        Connection* connection = findConnection(result.connectionId);
+        if (connection == nullptr) {
+            continue; // The client went away while the AI was thinking
+        }
+        connection->session.engineState = result.engineState;
+        applyAIMove(connection->session, result.move, result.player, *connection, &result.telemetry);
+        processInput(*connection);
+        flush(*connection);
+    }
+}
+
+void GameServer::onTimer() {
+    std::vector<uint64_t> playing(autoPlaying.begin(), autoPlaying.end());
+    for (uint64_t id : playing) {
+        Connection* connection = findConnection(id);
+        if (connection == nullptr) {
+            autoPlaying.erase(id);
+            continue;
+        }
+        stepAIvsAI(connection->session, *connection);
+        trackAutoPlay(*connection);
+        flush(*connection);
+    }
+}
+
+// Returns false if the connection was closed
+bool GameServer::flush(Connection& connection) {
+    if (backend == IoBackend::Uring) {
+        flushUring(connection);
+        return !connection.isClosed;
+    }
+    return flushEpoll(connection);
+}
+
+void GameServer::closeConnection(Connection& connection) {
+    if (connection.isClosed) {
+        return;
+    }
+    uint64_t id = connection.id;
+    autoPlaying.erase(id);
+
+    if (backend == IoBackend::Uring) {
+        closeUring(connection);
+        return;
+    }
+
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, connection.fd, nullptr);
+    close(connection.fd);
+    connections.erase(id);
+}
+
+void GameServer::runEpoll() {
+    const int MAX_EVENTS = 256;
+    epoll_event events[MAX_EVENTS];
+
+    while (!isStopRequested) {
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, 1000);
+        ioSyscalls++;
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "epoll_wait failed: " << strerror(errno) << std::endl;
+            break;
+        }
+
+        for (int i = 0; i < count; i++) {
+            EventKind kind = static_cast<EventKind>(events[i].data.u64 >> 56);
+            uint64_t value = events[i].data.u64 & ((1ull << 56) - 1);
+            uint64_t signalled;
+
+            switch (kind) {
+            case EVENT_TIMER:
+                ioSyscalls++;
+                if (read(timerFd, &signalled, sizeof(signalled)) > 0) {
+                    onTimer();
+                }
+                break;
+            case EVENT_COMPLETION:
+                ioSyscalls++;
+                if (read(completionFd, &signalled, sizeof(signalled)) > 0) {
+                    onCompletions();
+                }
+                break;
+            case EVENT_INBOX:
+                ioSyscalls++;
+                if (read(inboxFd, &signalled, sizeof(signalled)) > 0) {
+                    onInbox();
+                }
+                break;
+            case EVENT_LISTENER:
+                acceptConnections(listeners[value]);
+                break;
+            default: {
+                Connection* connection = findConnection(value);
+                if (connection == nullptr) {
+                    break;
+                }
+                if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                    closeConnection(*connection);
+                    break;
+                }
+                if ((events[i].events & EPOLLOUT) && !flushEpoll(*connection)) {
+                    break;
+                }
+                if (events[i].events & (EPOLLIN | EPOLLRDHUP)) {
+                    onReadable(*connection);
+                }
+                break;
+            }
+            }
+        }
+    }
+}
+
+void GameServer::acceptConnections(int listenFd) {
+    int fd;
+    while ((fd = acceptClient(listenFd)) >= 0) {
+        ioSyscalls++;
+        addConnection(fd, nextConnectionId++, true);
+    }
+    ioSyscalls++; // The accept that reported EAGAIN
+}
+
+void GameServer::onReadable(Connection& connection) {
+    char buffer[4096];
+    uint64_t id = connection.id;
+
+    while (true) {
+        ssize_t received = read(connection.fd, buffer, sizeof(buffer));
+        ioSyscalls++;
+        if (received == 0) {
+            closeConnection(connection);
+            return;
+        }
+        if (received < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            closeConnection(connection);
+            return;
+        }
+
+        onReceived(connection, buffer, received);
+        if (findConnection(id) == nullptr) {
+            return; // Closed while handling the input
+        }
+        if (static_cast<size_t>(received) < sizeof(buffer)) {
+            return; // Drained; a short read saves the extra read that would report EAGAIN
+        }
+    }
+}
+
+bool GameServer::flushEpoll(Connection& connection) {
+    size_t sent = 0;
+    while (sent < connection.output.size()) {
+        ssize_t result = connection.isSocket
+            ? send(connection.fd, connection.output.data() + sent, connection.output.size() - sent, MSG_NOSIGNAL)
+            : write(connection.fd, connection.output.data() + sent, connection.output.size() - sent);
+        ioSyscalls++;
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            closeConnection(connection);
+            return false;
+        }
+        sent += result;
+    }
+    connection.output.erase(0, sent);
+
+    // Wait for EPOLLOUT only while there is something left to send
+    bool isWaitingWritable = !connection.output.empty();
+    if (isWaitingWritable != connection.isWaitingWritable) {
+        connection.isWaitingWritable = isWaitingWritable;
+        epoll_event event = {};
+        event.events = EPOLLIN | EPOLLRDHUP | (isWaitingWritable ? static_cast<uint32_t>(EPOLLOUT) : 0);
+        event.data.u64 = eventData(EVENT_RECEIVE, connection.id);
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+        ioSyscalls++;
+    }
+    return true;
+}
@@ -0,0 +1,175 @@
+#ifndef GAME_SERVER_H
+#define GAME_SERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "GameProtocol.h"
+#include "IoUring.h"
+#include "RootParallelSearch.h"
+#include "SolvedGameFile.h"
+#include "SpscRing.h"
+#include "WorkStealingPool.h"
+
+enum class IoBackend {
+    Epoll, // readiness events plus one read/write syscall per operation
+    Uring  // io_uring: multishot receive into provided buffers, one io_uring_enter per loop turn
+};
+
+// Serves the sketch's command protocol over TCP and Unix-domain sockets and a
+// pseudo-terminal from a single event loop. Every connection owns one game session.
+// AI searches run on a work-stealing pool; their results are posted back
+// to the loop, which plays the move on the owning session.
+class GameServer {
+public:
+    // aiWorkers: 0 - one per core, negative - search on the event loop thread
+    explicit GameServer(int aiWorkers = 0, IoBackend backend = IoBackend::Epoll);
+    ~GameServer();
+
+    bool listenTcp(uint16_t port);
+    bool listenUnix(const std::string& path);
+
+    // Opens a pseudo-terminal that serial clients can use like a COM port.
+    // Returns the path of the slave side, or an empty string on failure
+    std::string listenPty();
+
+    void run();
+    void stop();
+
+    // Sharded mode: hands over a connection accepted on another thread. Only one
+    // thread may offer connections to a given server. Returns false if the inbox is full
+    bool offerConnection(int fd, uint64_t gameId);
+
+    size_t connectionCount() const { return connections.size(); }
+
+    // Maps a 3x3 solved games file (solve_games) for the PerfectPlay command
+    bool openSolvedGames(const std::string& path);
+
+    // Parallel: every AI move is split into one pool task per root move
+    void setRootSearch(RootSearch mode) { rootSearch = mode; }
+
+private:
+    static const size_t MAX_COMMAND_LENGTH = 256;
+    static const size_t MAX_PENDING_INPUT = 64 * 1024; // Pipelined commands waiting for an AI move
+
+    // Tags in the top byte of epoll data / io_uring user_data, the rest is an index or connection id
+    enum EventKind : uint64_t {
+        EVENT_LISTENER = 1,
+        EVENT_TIMER,
+        EVENT_COMPLETION,
+        EVENT_INBOX,
+        EVENT_RECEIVE,
+        EVENT_SEND
+    };
+
+    // Replies are collected in the output buffer and written once per batch of commands
+    struct Connection : public Print {
+        GameServer* server = nullptr;
+        int fd = -1;
+        uint64_t id = 0; // fds are reused, ids are not
+        bool isSocket = true;
+        bool isClosed = false;
+        bool isWaitingWritable = false; // epoll: EPOLLOUT is registered
+        int pendingOperations = 0;      // io_uring: submitted but not completed
+        std::string input;
+        std::string output;
+        std::string sending;            // io_uring: buffer of the send in flight
+        GameSession session = GameSession();
+
+        size_t write(uint8_t c) override;
+        size_t write(const uint8_t* buffer, size_t size) override;
+        using Print::write;
+    };
+
+    struct AIMoveResult {
+        uint64_t connectionId;
+        char player;
+        int move[2];
+        MoveTelemetry telemetry;
+        uint16_t engineState; // The session's engine state after the move, written back on the loop thread
+    };
+
+    struct IncomingConnection {
+        int fd;
+        uint64_t gameId;
+    };
+
+    IoBackend backend;
+    RootSearch rootSearch = RootSearch::Sequential;
+    int epollFd = -1;
+    int timerFd = -1;
+    int completionFd = -1; // eventfd signalled by pool workers
+    int inboxFd = -1;      // eventfd signalled by offerConnection()
+    int ptySlaveFd = -1;   // Kept open so the master never sees a hangup
+    std::atomic<bool> isStopRequested{ false };
+    uint64_t nextConnectionId = 1;
+    uint64_t ioSyscalls = 0;
+    uint64_t commandCount = 0;
+    uint64_t invalidCount = 0;     // Replies starting with "Invalid"
+    uint64_t txBytes = 0;
+    uint64_t worstInputMicros = 0; // Longest processInput(), inline AI moves included
+    size_t worstInputBacklog = 0;  // Most unprocessed bytes of one connection
+    std::unique_ptr<WorkStealingPool> aiPool;
+    std::mutex completionMutex;
+    std::vector<AIMoveResult> completions;
+    SpscRing<IncomingConnection, 1024> inbox;
+    std::vector<int> listeners;
+    std::vector<std::string> unixPaths;
+    std::unordered_map<uint64_t, std::unique_ptr<Connection>> connections;
+    std::unordered_set<uint64_t> autoPlaying;
+    SolvedGameFile solvedGames;
+
+    // io_uring backend state
+    std::unique_ptr<IoUring> ring;
+    uint64_t timerExpirations = 0;
+    uint64_t completionSignals = 0;
+    uint64_t inboxSignals = 0;
+
+    static uint64_t eventData(EventKind kind, uint64_t value) { return (static_cast<uint64_t>(kind) << 56) | value; }
+    static bool scheduleAIMove(GameSession& session, char player, Print& out);
+
+    bool addListener(int fd);
+    void addConnection(int fd, uint64_t id, bool isSocket);
+    Connection* findConnection(uint64_t id);
+    void onReceived(Connection& connection, const char* data, size_t size);
+    void processInput(Connection& connection);
+    void onTimer();
+    void onCompletions();
+    void onInbox();
+    void trackAutoPlay(Connection& connection);
+    bool flush(Connection& connection);
+    void closeConnection(Connection& connection);
+    void writeIoStats(Connection& connection);
+    void writeStats(Connection& connection);
+    void writePerfectPlay(Connection& connection);
+
+    // epoll backend (GameServer.cpp)
+    void runEpoll();
+    void acceptConnections(int listenFd);
+    void onReadable(Connection& connection);
+    bool flushEpoll(Connection& connection);
+
+    // io_uring backend (GameServerUring.cpp)
+    bool initUring();
+    bool probeUring();
+    void runUring();
+    // The arm and submit functions return false when the submission queue stays full
+    bool armAccept(size_t listenerIndex);
+    bool armReceive(Connection& connection);
+    bool armSignalRead(EventKind kind, int fd, uint64_t* value);
+    void rearm(bool isArmed);
+    void onUringCompletion(const io_uring_cqe& cqe);
+    void onUringReceive(uint64_t id, const io_uring_cqe& cqe);
+    void onUringSend(uint64_t id, int result);
+    bool submitSend(Connection& connection);
+    void flushUring(Connection& connection);
+    void closeUring(Connection& connection);
+};
+
+#endif
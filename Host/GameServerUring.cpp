@@ -0,0 +1,338 @@
+#include "GameServer.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+const unsigned RING_ENTRIES = 4096;
+const uint16_t RECEIVE_BUFFER_GROUP = 0;
+const uint16_t RECEIVE_BUFFER_COUNT = 1024; // Shared by all connections
+const uint32_t RECEIVE_BUFFER_SIZE = 4096;
+
+// user_data of the feature probe, below every EventKind
+const uint64_t PROBE_SKIPPED_NOP = 0;
+const uint64_t PROBE_RECEIVE = 0xFFFFFFFFull; // Never an event: the kind is in the top byte
+const uint64_t PROBE_CANCEL = 0xFFFFFFFEull;
+
+}
+
+bool GameServer::initUring() {
+    ring.reset(new IoUring());
+    if (!ring->init(RING_ENTRIES) || !ring->provideBuffers(RECEIVE_BUFFER_GROUP, RECEIVE_BUFFER_COUNT, RECEIVE_BUFFER_SIZE)
+        || !probeUring()) {
+        ring.reset();
+        return false;
+    }
+    return true;
+}
+
+// The backend needs multishot receives (Linux 6.0) and skipped completions (5.17). Older
+// kernels with io_uring fail them with -EINVAL or run the receive once, so both are tried
+// on a socket pair before the backend is chosen
+bool GameServer::probeUring() {
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sockets) < 0) {
+        return false;
+    }
+    bool isProbed = false;
+    bool isSkipSupported = true;
+    bool isMultishotSupported = false;
+    bool isReceiveDone = false;
+
+    io_uring_sqe* nop = ring->getSqe();
+    io_uring_sqe* receive = ring->getSqe();
+    if (nop != nullptr && receive != nullptr && write(sockets[1], "p", 1) == 1) {
+        nop->opcode = IORING_OP_NOP;
+        nop->flags = IOSQE_CQE_SKIP_SUCCESS;
+        nop->user_data = PROBE_SKIPPED_NOP;
+        receive->opcode = IORING_OP_RECV;
+        receive->fd = sockets[0];
+        receive->ioprio = IORING_RECV_MULTISHOT;
+        receive->flags = IOSQE_BUFFER_SELECT;
+        receive->buf_group = RECEIVE_BUFFER_GROUP;
+        receive->user_data = PROBE_RECEIVE;
+
+        auto onProbeCompletion = [&](const io_uring_cqe& cqe) {
+            if (cqe.user_data == PROBE_SKIPPED_NOP) {
+                isSkipSupported = false;
+            } else if (cqe.user_data == PROBE_RECEIVE) {
+                if (cqe.flags & IORING_CQE_F_BUFFER) {
+                    ring->recycleBuffer(static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT));
+                }
+                if (cqe.flags & IORING_CQE_F_MORE) {
+                    isMultishotSupported = (cqe.res == 1);
+                } else {
+                    isReceiveDone = true;
+                }
+            }
+        };
+        isProbed = ring->submitAndWait(1) >= 0;
+        ring->drainCompletions(onProbeCompletion);
+
+        // A working multishot receive is still armed and is cancelled before the server starts
+        if (isProbed && !isReceiveDone) {
+            io_uring_sqe* cancel = ring->getSqe();
+            if (cancel == nullptr) {
+                isProbed = false;
+            } else {
+                cancel->opcode = IORING_OP_ASYNC_CANCEL;
+                cancel->addr = PROBE_RECEIVE;
+                cancel->user_data = PROBE_CANCEL;
+            }
+            while (isProbed && !isReceiveDone) {
+                isProbed = ring->submitAndWait(1) >= 0;
+                ring->drainCompletions(onProbeCompletion);
+            }
+        }
+    }
+    close(sockets[0]);
+    close(sockets[1]);
+
+    if (!isProbed || !isSkipSupported || !isMultishotSupported) {
+        std::cerr << "io_uring: kernel lacks " << (!isProbed ? "a working ring"
+            : !isSkipSupported ? "IOSQE_CQE_SKIP_SUCCESS" : "multishot receives") << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Everything is submitted in one io_uring_enter per loop turn, which also waits for the
+// next completions. Sockets are read by multishot receives into the shared provided buffers,
+// so an idle connection costs no syscalls and a busy one costs none per read.
+void GameServer::runUring() {
+    rearm(armSignalRead(EVENT_TIMER, timerFd, &timerExpirations));
+    rearm(armSignalRead(EVENT_INBOX, inboxFd, &inboxSignals));
+    if (completionFd >= 0) {
+        rearm(armSignalRead(EVENT_COMPLETION, completionFd, &completionSignals));
+    }
+
+    while (!isStopRequested) {
+        if (ring->submitAndWait(1) < 0) {
+            std::cerr << "io_uring_enter failed: " << strerror(errno) << std::endl;
+            break;
+        }
+        ring->drainCompletions([this](const io_uring_cqe& cqe) { onUringCompletion(cqe); });
+    }
+}
+
+// A listener or signal that cannot be re-armed would silently stop the server, so it stops openly
+void GameServer::rearm(bool isArmed) {
+    if (!isArmed) {
+        std::cerr << "io_uring: submission queue is full, stopping" << std::endl;
+        isStopRequested = true;
+    }
+}
+
+bool GameServer::armAccept(size_t listenerIndex) {
+    io_uring_sqe* sqe = ring->getSqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = listeners[listenerIndex];
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    sqe->user_data = eventData(EVENT_LISTENER, listenerIndex);
+    return true;
+}
+
+// Sockets: one multishot receive for the connection's lifetime.
+// The pty master does not support it and is re-armed after every read
+bool GameServer::armReceive(Connection& connection) {
+    io_uring_sqe* sqe = ring->getSqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = connection.isSocket ? IORING_OP_RECV : IORING_OP_READ;
+    sqe->fd = connection.fd;
+    if (connection.isSocket) {
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+    } else {
+        sqe->len = RECEIVE_BUFFER_SIZE;
+        sqe->off = static_cast<uint64_t>(-1);
+    }
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = RECEIVE_BUFFER_GROUP;
+    sqe->user_data = eventData(EVENT_RECEIVE, connection.id);
+    connection.pendingOperations++;
+    return true;
+}
+
+bool GameServer::armSignalRead(EventKind kind, int fd, uint64_t* value) {
+    io_uring_sqe* sqe = ring->getSqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(value);
+    sqe->len = sizeof(*value);
+    sqe->off = static_cast<uint64_t>(-1);
+    sqe->user_data = eventData(kind, 0);
+    return true;
+}
+
+void GameServer::onUringCompletion(const io_uring_cqe& cqe) {
+    EventKind kind = static_cast<EventKind>(cqe.user_data >> 56);
+    uint64_t value = cqe.user_data & ((1ull << 56) - 1);
+
+    switch (kind) {
+    case EVENT_LISTENER:
+        if (cqe.res >= 0) {
+            int noDelay = 1;
+            setsockopt(cqe.res, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay)); // Fails harmlessly on Unix sockets
+            ioSyscalls++;
+            addConnection(cqe.res, nextConnectionId++, true);
+        }
+        if (!(cqe.flags & IORING_CQE_F_MORE) && !isStopRequested) {
+            rearm(armAccept(value));
+        }
+        break;
+    case EVENT_TIMER:
+        if (cqe.res > 0) {
+            onTimer();
+        }
+        rearm(armSignalRead(EVENT_TIMER, timerFd, &timerExpirations));
+        break;
+    case EVENT_COMPLETION:
+        if (cqe.res > 0) {
+            onCompletions();
+        }
+        rearm(armSignalRead(EVENT_COMPLETION, completionFd, &completionSignals));
+        break;
+    case EVENT_INBOX:
+        if (cqe.res > 0) {
+            onInbox();
+        }
+        rearm(armSignalRead(EVENT_INBOX, inboxFd, &inboxSignals));
+        break;
+    case EVENT_RECEIVE:
+        onUringReceive(value, cqe);
+        break;
+    case EVENT_SEND:
+        onUringSend(value, cqe.res);
+        break;
+    default:
+        break; // Cancellations
+    }
+}
+
+void GameServer::onUringReceive(uint64_t id, const io_uring_cqe& cqe) {
+    bool hasBuffer = (cqe.flags & IORING_CQE_F_BUFFER) != 0;
+    uint16_t bufferId = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+
+    Connection* connection = findConnection(id);
+    if (connection != nullptr && hasBuffer && cqe.res > 0) {
+        onReceived(*connection, ring->providedBuffer(bufferId), cqe.res);
+    }
+    if (hasBuffer) {
+        ring->recycleBuffer(bufferId);
+    }
+    if (cqe.flags & IORING_CQE_F_MORE) {
+        return;
+    }
+
+    // The receive has ended: re-arm it, or finish closing the connection
+    auto found = connections.find(id);
+    if (found == connections.end()) {
+        return;
+    }
+    connection = found->second.get();
+    connection->pendingOperations--;
+    if (connection->isClosed) {
+        if (connection->pendingOperations == 0) {
+            connections.erase(found);
+        }
+    } else if ((cqe.res > 0 || cqe.res == -ENOBUFS) && armReceive(*connection)) {
+        return;
+    } else {
+        closeConnection(*connection);
+    }
+}
+
+void GameServer::onUringSend(uint64_t id, int result) {
+    auto found = connections.find(id);
+    if (found == connections.end()) {
+        return;
+    }
+    Connection& connection = *found->second;
+    connection.pendingOperations--;
+    if (connection.isClosed) {
+        if (connection.pendingOperations == 0) {
+            connections.erase(found);
+        }
+        return;
+    }
+    if (result < 0) {
+        closeConnection(connection);
+        return;
+    }
+
+    connection.sending.erase(0, result);
+    if (!connection.sending.empty()) {
+        if (!submitSend(connection)) { // Partial send, the socket buffer is full
+            closeConnection(connection);
+        }
+    } else {
+        flushUring(connection);
+    }
+}
+
+bool GameServer::submitSend(Connection& connection) {
+    io_uring_sqe* sqe = ring->getSqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = connection.isSocket ? IORING_OP_SEND : IORING_OP_WRITE;
+    sqe->fd = connection.fd;
+    sqe->addr = reinterpret_cast<uint64_t>(connection.sending.data());
+    sqe->len = static_cast<uint32_t>(connection.sending.size());
+    if (connection.isSocket) {
+        sqe->msg_flags = MSG_NOSIGNAL;
+    } else {
+        sqe->off = static_cast<uint64_t>(-1);
+    }
+    sqe->user_data = eventData(EVENT_SEND, connection.id);
+    connection.pendingOperations++;
+    return true;
+}
+
+// At most one send per connection is in flight. Replies produced meanwhile
+// collect in the output buffer and go out together when it completes
+void GameServer::flushUring(Connection& connection) {
+    if (connection.isClosed || !connection.sending.empty() || connection.output.empty()) {
+        return;
+    }
+    connection.sending.swap(connection.output);
+    if (!submitSend(connection)) {
+        closeConnection(connection);
+    }
+}
+
+// Operations in flight still point into the connection, so it is freed with the last
+// completion. Cancelling the receive ends the multishot request and the pty read; without
+// a free entry the socket shutdown still ends the receive
+void GameServer::closeUring(Connection& connection) {
+    connection.isClosed = true;
+    io_uring_sqe* sqe = ring->getSqe();
+    if (sqe != nullptr) {
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->addr = eventData(EVENT_RECEIVE, connection.id);
+        sqe->user_data = 0;
+    }
+    if (connection.isSocket) {
+        shutdown(connection.fd, SHUT_RDWR);
+    }
+    close(connection.fd);
+    ioSyscalls += connection.isSocket ? 2 : 1;
+    if (connection.pendingOperations == 0) {
+        connections.erase(connection.id);
+    }
+}
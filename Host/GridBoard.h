@@ -0,0 +1,119 @@
+#ifndef GRID_BOARD_H
+#define GRID_BOARD_H
+
+#include <cstdint>
+#include <vector>
+
+// N×N board with K marks in a row to win, for the host-side search tools.
+// One bitboard per side, cell k = row * size + column; boards up to 8x8.
+// X always starts, so the side to move follows from the piece counts, like sideToMove() in GameCore.h
+const int MAX_GRID_SIZE = 8;
+
+struct GridPosition {
+    uint64_t x = 0;
+    uint64_t o = 0;
+};
+
+class GridGame {
+public:
+    GridGame(int size, int winLength) : boardSize(size), lineLength(winLength), linesByCell(size * size) {
+        allCells = (size * size == 64) ? ~0ull : (1ull << (size * size)) - 1;
+        const int directions[4][2] = { { 0, 1 }, { 1, 0 }, { 1, 1 }, { 1, -1 } };
+        for (int row = 0; row < size; row++) {
+            for (int column = 0; column < size; column++) {
+                for (const int* direction : directions) {
+                    int lastRow = row + direction[0] * (winLength - 1);
+                    int lastColumn = column + direction[1] * (winLength - 1);
+                    if (lastRow < 0 || lastRow >= size || lastColumn < 0 || lastColumn >= size) {
+                        continue;
+                    }
+                    uint64_t line = 0;
+                    for (int k = 0; k < winLength; k++) {
+                        line |= 1ull << ((row + direction[0] * k) * size + column + direction[1] * k);
+                    }
+                    winLines.push_back(line);
+                }
+            }
+        }
+        for (uint64_t line : winLines) {
+            for (int cell = 0; cell < size * size; cell++) {
+                if (line & (1ull << cell)) {
+                    linesByCell[cell].push_back(line);
+                }
+            }
+        }
+    }
+
+    int size() const { return boardSize; }
+    int cellCount() const { return boardSize * boardSize; }
+    int winLength() const { return lineLength; }
+    uint64_t cellMask() const { return allCells; }
+    const std::vector<uint64_t>& lines() const { return winLines; }
+
+    static bool isXToMove(const GridPosition& position) {
+        return __builtin_popcountll(position.x) == __builtin_popcountll(position.o);
+    }
+
+    uint64_t emptyCells(const GridPosition& position) const {
+        return ~(position.x | position.o) & allCells;
+    }
+
+    bool isFull(const GridPosition& position) const {
+        return emptyCells(position) == 0;
+    }
+
+    static GridPosition withMove(GridPosition position, int cell) {
+        if (isXToMove(position)) {
+            position.x |= 1ull << cell;
+        } else {
+            position.o |= 1ull << cell;
+        }
+        return position;
+    }
+
+    // Base-3 index, sum of cell * 3^k with cells 0 empty, 1 X, 2 O: 0..3^(N·N)-1.
+    // Same numbering as positionIndex() in GameCore.h for 3x3
+    uint64_t indexOf(const GridPosition& position) const {
+        uint64_t index = 0;
+        for (int cell = cellCount() - 1; cell >= 0; cell--) {
+            index = index * 3 + ((position.x >> cell) & 1) + 2 * ((position.o >> cell) & 1);
+        }
+        return index;
+    }
+
+    uint64_t indexCount() const {
+        uint64_t count = 1;
+        for (int cell = 0; cell < cellCount(); cell++) {
+            count *= 3;
+        }
+        return count;
+    }
+
+    bool isWin(uint64_t pieces) const {
+        for (uint64_t line : winLines) {
+            if ((pieces & line) == line) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Only lines through the last move can have been completed by it
+    bool isWinThrough(uint64_t pieces, int cell) const {
+        for (uint64_t line : linesByCell[cell]) {
+            if ((pieces & line) == line) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    int boardSize;
+    int lineLength;
+    uint64_t allCells;
+    std::vector<uint64_t> winLines;
+    std::vector<std::vector<uint64_t>> linesByCell;
+};
+
+#endif
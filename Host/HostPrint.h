@@ -0,0 +1,70 @@
+#ifndef HOST_PRINT_H
+#define HOST_PRINT_H
+
+// The subset of Arduino's Print class used by GameProtocol, for host builds.
+// Line endings are "\r\n" like on the board, so clients see identical replies.
+// micros() stands in for the board's clock in the telemetry timings. Flash strings
+// (F(), PSTR() and the _P string functions) are ordinary strings on the host.
+
+#include <chrono>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+class __FlashStringHelper;
+#define PSTR(string_literal) (string_literal)
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(PSTR(string_literal)))
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define strlen_P strlen
+
+inline unsigned long micros() {
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+class Print {
+public:
+    virtual ~Print() = default;
+
+    virtual size_t write(uint8_t c) = 0;
+
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t written = 0;
+        while (size--) {
+            written += write(*buffer++);
+        }
+        return written;
+    }
+
+    size_t write(const char* buffer, size_t size) {
+        return write(reinterpret_cast<const uint8_t*>(buffer), size);
+    }
+
+    size_t print(const char* text) { return write(text, strlen(text)); }
+    size_t print(const __FlashStringHelper* text) { return print(reinterpret_cast<const char*>(text)); }
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+    size_t print(int value) { return print(static_cast<long>(value)); }
+    size_t print(unsigned int value) { return print(static_cast<unsigned long>(value)); }
+
+    size_t print(long value) {
+        char buffer[24];
+        return write(buffer, snprintf(buffer, sizeof(buffer), "%ld", value));
+    }
+
+    size_t print(unsigned long value) {
+        char buffer[24];
+        return write(buffer, snprintf(buffer, sizeof(buffer), "%lu", value));
+    }
+
+    size_t println() { return write("\r\n", 2); }
+
+    template <typename T>
+    size_t println(T value) {
+        size_t written = print(value);
+        return written + println();
+    }
+};
+
+#endif
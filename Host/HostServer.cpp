@@ -0,0 +1,138 @@
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "Engines.h"
+#include "GameServer.h"
+#include "ShardedServer.h"
+
+static GameServer* runningServer = nullptr;
+static ShardedServer* runningShardedServer = nullptr;
+
+static void onSignal(int) {
+    if (runningServer) {
+        runningServer->stop();
+    }
+    if (runningShardedServer) {
+        runningShardedServer->stop();
+    }
+}
+
+template <typename Server>
+static bool startListening(Server& server, int tcpPort, const std::string& unixPath, const std::string& solvedPath) {
+    if (!solvedPath.empty() && !server.openSolvedGames(solvedPath)) {
+        return false;
+    }
+    if (tcpPort >= 0 && !server.listenTcp(static_cast<uint16_t>(tcpPort))) {
+        return false;
+    }
+    if (!unixPath.empty() && !server.listenUnix(unixPath)) {
+        return false;
+    }
+    return true;
+}
+
+static void printListening(int tcpPort, const std::string& unixPath) {
+    std::cout << "Tic-Tac-Toe host server is running";
+    if (tcpPort >= 0) {
+        std::cout << ", TCP port " << tcpPort;
+    }
+    if (!unixPath.empty()) {
+        std::cout << ", Unix socket " << unixPath;
+    }
+}
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [--tcp <port>] [--unix <path>] [--pty] [--ai-workers <count>] [--shards <count>] [--io epoll|uring] [--root-parallel] [--solved <file>]" << std::endl;
+    std::cout << "Without options listens on TCP port 5555." << std::endl;
+    std::cout << "--pty: also serve a pseudo-terminal, the client can open its path like a COM port." << std::endl;
+    std::cout << "--ai-workers: threads for AI moves, 0 - one per core (default), -1 - event loop thread." << std::endl;
+    std::cout << "--shards: run one pinned event loop per shard, 0 - one per core. AI moves run on the shard." << std::endl;
+    std::cout << "--root-parallel: split every AI move into one pool task per root move (same moves as sequential)." << std::endl;
+    std::cout << "--solved: map a 3x3 file written by solve_games and answer PerfectPlay." << std::endl;
+    std::cout << "--io: event loop backend, epoll (default) or io_uring." << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int tcpPort = -1;
+    std::string unixPath;
+    std::string solvedPath;
+    int aiWorkers = 0;
+    int shardCount = -1;
+    bool isPtyEnabled = false;
+    bool isRootParallel = false;
+    IoBackend backend = IoBackend::Epoll;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tcp") == 0 && i + 1 < argc) {
+            tcpPort = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--unix") == 0 && i + 1 < argc) {
+            unixPath = argv[++i];
+        } else if (strcmp(argv[i], "--ai-workers") == 0 && i + 1 < argc) {
+            aiWorkers = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--shards") == 0 && i + 1 < argc) {
+            shardCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--solved") == 0 && i + 1 < argc) {
+            solvedPath = argv[++i];
+        } else if (strcmp(argv[i], "--root-parallel") == 0) {
+            isRootParallel = true;
+        } else if (strcmp(argv[i], "--pty") == 0) {
+            isPtyEnabled = true;
+        } else if (strcmp(argv[i], "--io") == 0 && i + 1 < argc && strcmp(argv[i + 1], "epoll") == 0) {
+            backend = IoBackend::Epoll;
+            i++;
+        } else if (strcmp(argv[i], "--io") == 0 && i + 1 < argc && strcmp(argv[i + 1], "uring") == 0) {
+            backend = IoBackend::Uring;
+            i++;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (tcpPort < 0 && unixPath.empty() && !isPtyEnabled) {
+        tcpPort = 5555;
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    signal(SIGPIPE, SIG_IGN); // Closed connections are reported by send()/write()
+    initEngines();
+
+    if (shardCount >= 0) {
+        if (isPtyEnabled) {
+            std::cerr << "--pty is not supported with --shards" << std::endl;
+            return 1;
+        }
+        ShardedServer server(static_cast<unsigned>(shardCount), backend);
+        if (!startListening(server, tcpPort, unixPath, solvedPath)) {
+            return 1;
+        }
+        runningShardedServer = &server;
+        printListening(tcpPort, unixPath);
+        std::cout << ", " << server.shardCount() << " shards" << std::endl;
+        server.run();
+        runningShardedServer = nullptr;
+        return 0;
+    }
+
+    GameServer server(aiWorkers, backend);
+    server.setRootSearch(isRootParallel ? RootSearch::Parallel : RootSearch::Sequential);
+    if (!startListening(server, tcpPort, unixPath, solvedPath)) {
+        return 1;
+    }
+    std::string ptyPath;
+    if (isPtyEnabled && (ptyPath = server.listenPty()).empty()) {
+        return 1;
+    }
+    runningServer = &server;
+    printListening(tcpPort, unixPath);
+    if (!ptyPath.empty()) {
+        std::cout << ", pseudo-terminal " << ptyPath;
+    }
+    std::cout << std::endl;
+    server.run();
+    runningServer = nullptr;
+    return 0;
+}
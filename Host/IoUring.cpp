@@ -0,0 +1,164 @@
+#include "IoUring.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+IoUring::~IoUring() {
+    free(bufferMemory);
+    if (sqes) {
+        munmap(sqes, sqesSize);
+    }
+    if (cqRing && cqRing != sqRing) {
+        munmap(cqRing, cqRingSize);
+    }
+    if (sqRing) {
+        munmap(sqRing, sqRingSize);
+    }
+    if (ringFd >= 0) {
+        close(ringFd);
+    }
+}
+
+bool IoUring::init(unsigned entries) {
+    io_uring_params params = {};
+    ringFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (ringFd < 0) {
+        std::cerr << "io_uring_setup failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP)) {
+        std::cerr << "io_uring: kernel is too old (no single mmap)" << std::endl;
+        return false;
+    }
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (cqRingSize > sqRingSize) {
+        sqRingSize = cqRingSize;
+    }
+    cqRingSize = sqRingSize;
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+        sqRing = nullptr;
+        std::cerr << "io_uring: failed to map rings: " << strerror(errno) << std::endl;
+        return false;
+    }
+    cqRing = sqRing;
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* mappedSqes = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+    if (mappedSqes == MAP_FAILED) {
+        std::cerr << "io_uring: failed to map submission entries: " << strerror(errno) << std::endl;
+        return false;
+    }
+    sqes = static_cast<io_uring_sqe*>(mappedSqes);
+
+    char* sq = static_cast<char*>(sqRing);
+    sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    sqLocalTail = *sqTail;
+    sqSubmitted = sqLocalTail;
+
+    char* cq = static_cast<char*>(cqRing);
+    cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    return true;
+}
+
+io_uring_sqe* IoUring::getSqe() {
+    unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    while (sqLocalTail - head > *sqMask) {
+        if (submitAndWait(0) <= 0) {
+            return nullptr; // The kernel takes no entries, e.g. -EBUSY while completions overflow
+        }
+        head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    }
+
+    unsigned index = sqLocalTail & *sqMask;
+    io_uring_sqe* sqe = &sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqArray[index] = index;
+    sqLocalTail++;
+    return sqe;
+}
+
+int IoUring::submitAndWait(unsigned waitCount) {
+    unsigned toSubmit = sqLocalTail - sqSubmitted;
+    __atomic_store_n(sqTail, sqLocalTail, __ATOMIC_RELEASE);
+    if (toSubmit == 0 && waitCount == 0) {
+        return 0;
+    }
+
+    unsigned flags = (waitCount > 0) ? IORING_ENTER_GETEVENTS : 0;
+    while (true) {
+        enterCount++;
+        int result = static_cast<int>(syscall(__NR_io_uring_enter, ringFd, toSubmit, waitCount, flags, nullptr, 0));
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result >= 0) {
+            sqSubmitted += result;
+        }
+        return result;
+    }
+}
+
+bool IoUring::provideBuffers(uint16_t groupId, uint16_t bufferCount, uint32_t size) {
+    bufferMemory = static_cast<char*>(malloc(static_cast<size_t>(bufferCount) * size));
+    if (bufferMemory == nullptr) {
+        return false;
+    }
+    bufferGroup = groupId;
+    bufferSize = size;
+
+    io_uring_sqe* sqe = getSqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+    sqe->fd = bufferCount;
+    sqe->addr = reinterpret_cast<uint64_t>(bufferMemory);
+    sqe->len = size;
+    sqe->buf_group = groupId;
+    sqe->off = 0;
+    return submitAndWait(1) >= 0 && drainCompletions([](const io_uring_cqe& cqe) {
+        if (cqe.res < 0) {
+            std::cerr << "io_uring: failed to provide buffers: " << strerror(-cqe.res) << std::endl;
+        }
+    }) == 1;
+}
+
+// Hands the buffer back with the next submission. Successful completions are skipped.
+// Without a free entry the buffer waits for the next call
+void IoUring::recycleBuffer(uint16_t bufferId) {
+    unrecycledBuffers.push_back(bufferId);
+    while (!unrecycledBuffers.empty()) {
+        io_uring_sqe* sqe = getSqe();
+        if (sqe == nullptr) {
+            return;
+        }
+        queueRecycle(sqe, unrecycledBuffers.back());
+        unrecycledBuffers.pop_back();
+    }
+}
+
+void IoUring::queueRecycle(io_uring_sqe* sqe, uint16_t bufferId) {
+    sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+    sqe->flags = IOSQE_CQE_SKIP_SUCCESS;
+    sqe->fd = 1;
+    sqe->addr = reinterpret_cast<uint64_t>(providedBuffer(bufferId));
+    sqe->len = bufferSize;
+    sqe->buf_group = bufferGroup;
+    sqe->off = bufferId;
+}
@@ -0,0 +1,84 @@
+#ifndef IO_URING_H
+#define IO_URING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <linux/io_uring.h>
+
+// Minimal io_uring wrapper over the raw syscalls (liburing is not required).
+// One ring per thread: submission and completion are not synchronized.
+class IoUring {
+public:
+    IoUring() = default;
+    ~IoUring();
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    bool init(unsigned entries);
+
+    // Next free submission entry, already zeroed. Submits pending entries first if the queue is
+    // full; nullptr if the kernel takes none of them
+    io_uring_sqe* getSqe();
+
+    // Submits everything queued and waits for at least waitCount completions
+    int submitAndWait(unsigned waitCount);
+
+    // Calls handler(const io_uring_cqe&) for every available completion
+    template <typename Handler>
+    unsigned drainCompletions(Handler handler) {
+        unsigned head = *cqHead;
+        unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        unsigned count = 0;
+        while (head != tail) {
+            handler(cqes[head & *cqMask]);
+            head++;
+            count++;
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+        return count;
+    }
+
+    // Hands bufferCount buffers of bufferSize bytes to the kernel as group groupId.
+    // Receives with IOSQE_BUFFER_SELECT pick one when data arrives, so idle
+    // connections hold no memory. Must be called before anything else is queued
+    bool provideBuffers(uint16_t groupId, uint16_t bufferCount, uint32_t bufferSize);
+    char* providedBuffer(uint16_t bufferId) const { return bufferMemory + static_cast<size_t>(bufferId) * bufferSize; }
+    void recycleBuffer(uint16_t bufferId);
+
+    uint64_t enterCalls() const { return enterCount; }
+
+private:
+    void queueRecycle(io_uring_sqe* sqe, uint16_t bufferId);
+
+    int ringFd = -1;
+    void* sqRing = nullptr;
+    void* cqRing = nullptr;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqesSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqMask = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqLocalTail = 0;
+    unsigned sqSubmitted = 0;
+
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned* cqMask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+
+    char* bufferMemory = nullptr;
+    uint32_t bufferSize = 0;
+    uint16_t bufferGroup = 0;
+    std::vector<uint16_t> unrecycledBuffers;
+
+    uint64_t enterCount = 0;
+};
+
+#endif
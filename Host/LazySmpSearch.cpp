@@ -0,0 +1,253 @@
+#include "LazySmpSearch.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+
+#include "Tablebase.h"
+
+static const int INFINITE_SCORE = 30000;
+static const int DECISIVE_SCORE = LazySmpSearch::WIN_SCORE - 1000;
+
+// The table keeps win scores relative to the node, so they stay valid at any ply
+static int toTableScore(int score, int ply) {
+    return score > DECISIVE_SCORE ? score + ply : score < -DECISIVE_SCORE ? score - ply : score;
+}
+
+static int fromTableScore(int score, int ply) {
+    return score > DECISIVE_SCORE ? score - ply : score < -DECISIVE_SCORE ? score + ply : score;
+}
+
+static uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+LazySmpSearch::LazySmpSearch(const GridGame& game, unsigned threads, size_t hashMegabytes, bool useHugePages)
+    : game(game), threads(threads), table(hashMegabytes, useHugePages) {
+    if (this->threads == 0) {
+        this->threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    uint64_t seed = 0x5EED;
+    for (int k = 0; k < 2 * game.cellCount(); k++) {
+        zobrist.push_back(splitMix64(seed));
+    }
+
+    int size = game.size();
+    for (int cell = 0; cell < game.cellCount(); cell++) {
+        moveOrder.push_back(cell);
+    }
+    auto distance = [size](int cell) {
+        int row = 2 * (cell / size) - (size - 1);
+        int column = 2 * (cell % size) - (size - 1);
+        return std::max(std::abs(row), std::abs(column)) * 2 + std::min(std::abs(row), std::abs(column));
+    };
+    std::stable_sort(moveOrder.begin(), moveOrder.end(), [&](int a, int b) { return distance(a) < distance(b); });
+}
+
+bool LazySmpSearch::setTablebase(const BlockTablebaseFile* tablebase) {
+    if (tablebase && (tablebase->boardSize() != game.size() || tablebase->winLength() != game.winLength())) {
+        return false;
+    }
+    this->tablebase = tablebase;
+    return true;
+}
+
+LazySmpSearch::Result LazySmpSearch::search(const GridPosition& position, int depth) {
+    int emptyCount = __builtin_popcountll(game.emptyCells(position));
+    depth = std::max(1, std::min(depth, emptyCount));
+
+    isStopping = false;
+    hasResult = false;
+    result = Result();
+
+    std::vector<Worker> workers(threads);
+    std::vector<std::thread> helpers;
+    for (unsigned i = 1; i < threads; i++) {
+        workers[i].index = i;
+        helpers.emplace_back([this, &workers, i, &position, depth]() { runWorker(workers[i], position, depth); });
+    }
+    runWorker(workers[0], position, depth);
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+
+    for (const Worker& worker : workers) {
+        result.nodes += worker.nodes;
+        result.tablebaseHits += worker.tablebaseHits;
+    }
+    return result;
+}
+
+void LazySmpSearch::runWorker(Worker& worker, const GridPosition& root, int targetDepth) {
+    uint64_t key = keyOf(root);
+
+    // Odd helpers run one ply ahead of the main thread
+    for (int depth = 1 + (worker.index % 2); depth <= targetDepth && !isStopping; depth++) {
+        int move = -1;
+        int score = searchRoot(worker, root, key, depth, move);
+        if (isStopping) {
+            break;
+        }
+        if (depth == targetDepth) {
+            bool expected = false;
+            if (hasResult.compare_exchange_strong(expected, true)) {
+                result.move = move;
+                result.score = score;
+                result.depth = depth;
+                isStopping = true;
+            }
+        }
+    }
+}
+
+int LazySmpSearch::searchRoot(Worker& worker, const GridPosition& root, uint64_t key, int depth, int& bestMove) {
+    TranspositionTable::Entry entry;
+    int tableMove = table.probe(key, entry) ? entry.move : -1;
+
+    // Helpers rotate the root moves so that each starts on a different subtree
+    std::vector<int> moves;
+    uint64_t empty = game.emptyCells(root);
+    for (int cell : moveOrder) {
+        if ((empty & (1ull << cell)) && cell != tableMove) {
+            moves.push_back(cell);
+        }
+    }
+    if (worker.index > 0 && !moves.empty()) {
+        std::rotate(moves.begin(), moves.begin() + worker.index % moves.size(), moves.end());
+    }
+    if (tableMove >= 0 && (empty & (1ull << tableMove))) {
+        moves.insert(moves.begin(), tableMove);
+    }
+
+    int alpha = -INFINITE_SCORE;
+    bestMove = -1;
+    for (int cell : moves) {
+        GridPosition child = GridGame::withMove(root, cell);
+        int score = -negamax(worker, child, key ^ moveKey(root, cell), cell, depth - 1, 1, -INFINITE_SCORE, -alpha);
+        if (isStopping) {
+            return 0;
+        }
+        if (score > alpha) {
+            alpha = score;
+            bestMove = cell;
+        }
+    }
+
+    TranspositionTable::Entry stored;
+    stored.score = alpha;
+    stored.depth = depth;
+    stored.move = bestMove;
+    stored.bound = TranspositionTable::BOUND_EXACT;
+    table.store(key, stored);
+    return alpha;
+}
+
+int LazySmpSearch::negamax(Worker& worker, const GridPosition& position, uint64_t key, int lastCell, int depth, int ply, int alpha, int beta) {
+    worker.nodes++;
+    bool isXToMove = GridGame::isXToMove(position);
+    uint64_t lastMover = isXToMove ? position.o : position.x;
+    if (game.isWinThrough(lastMover, lastCell)) {
+        return -(WIN_SCORE - ply);
+    }
+    uint64_t empty = game.emptyCells(position);
+    if (empty == 0) {
+        return 0;
+    }
+    if (depth == 0) {
+        if (tablebase) {
+            worker.tablebaseHits++;
+            uint8_t value = tablebase->probe(game.indexOf(position));
+            return (value == WDL_WIN) ? TABLEBASE_WIN_SCORE - ply : (value == WDL_LOSS) ? -(TABLEBASE_WIN_SCORE - ply) : 0;
+        }
+        return evaluate(position);
+    }
+
+    int originalAlpha = alpha;
+    int tableMove = -1;
+    TranspositionTable::Entry entry;
+    if (table.probe(key, entry)) {
+        tableMove = entry.move;
+        if (entry.depth >= depth) {
+            int score = fromTableScore(entry.score, ply);
+            if (entry.bound == TranspositionTable::BOUND_EXACT) {
+                return score;
+            } else if (entry.bound == TranspositionTable::BOUND_LOWER) {
+                alpha = std::max(alpha, score);
+            } else if (entry.bound == TranspositionTable::BOUND_UPPER) {
+                beta = std::min(beta, score);
+            }
+            if (alpha >= beta) {
+                return score;
+            }
+        }
+    }
+
+    int bestScore = -INFINITE_SCORE;
+    int bestMove = -1;
+    for (int k = -1; k < static_cast<int>(moveOrder.size()); k++) {
+        int cell = (k < 0) ? tableMove : moveOrder[k];
+        if (cell < 0 || !(empty & (1ull << cell)) || (k >= 0 && cell == tableMove)) {
+            continue;
+        }
+
+        GridPosition child = GridGame::withMove(position, cell);
+        int score = -negamax(worker, child, key ^ moveKey(position, cell), cell, depth - 1, ply + 1, -beta, -alpha);
+        if (isStopping.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = cell;
+        }
+        if (score > alpha) {
+            alpha = score;
+            if (alpha >= beta) {
+                break;
+            }
+        }
+    }
+
+    TranspositionTable::Entry stored;
+    stored.score = toTableScore(bestScore, ply);
+    stored.depth = depth;
+    stored.move = bestMove;
+    stored.bound = (bestScore <= originalAlpha) ? TranspositionTable::BOUND_UPPER
+        : (bestScore >= beta) ? TranspositionTable::BOUND_LOWER : TranspositionTable::BOUND_EXACT;
+    table.store(key, stored);
+    return bestScore;
+}
+
+// Lines still open for one side only, weighted by the square of their marks
+int LazySmpSearch::evaluate(const GridPosition& position) const {
+    int score = 0;
+    for (uint64_t line : game.lines()) {
+        int xCount = __builtin_popcountll(position.x & line);
+        int oCount = __builtin_popcountll(position.o & line);
+        if (oCount == 0) {
+            score += xCount * xCount;
+        } else if (xCount == 0) {
+            score -= oCount * oCount;
+        }
+    }
+    return GridGame::isXToMove(position) ? score : -score;
+}
+
+uint64_t LazySmpSearch::keyOf(const GridPosition& position) const {
+    uint64_t key = 0;
+    for (int cell = 0; cell < game.cellCount(); cell++) {
+        if (position.x & (1ull << cell)) {
+            key ^= zobrist[2 * cell];
+        } else if (position.o & (1ull << cell)) {
+            key ^= zobrist[2 * cell + 1];
+        }
+    }
+    return key;
+}
+
+uint64_t LazySmpSearch::moveKey(const GridPosition& position, int cell) const {
+    return zobrist[2 * cell + (GridGame::isXToMove(position) ? 0 : 1)];
+}
@@ -0,0 +1,67 @@
+#ifndef LAZY_SMP_SEARCH_H
+#define LAZY_SMP_SEARCH_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "BlockTablebaseFile.h"
+#include "GridBoard.h"
+#include "TranspositionTable.h"
+
+// Alpha-beta search for N×N boards, parallelized with Lazy SMP: every thread runs its own
+// iterative deepening on the same root and they cooperate only through the shared
+// transposition table. Helpers start at staggered depths and with rotated root moves,
+// so they fill the table with entries the other threads have not searched yet.
+// The first thread to finish the requested depth supplies the result and stops the others.
+class LazySmpSearch {
+public:
+    static const int WIN_SCORE = 10000; // Won positions score WIN_SCORE - ply
+    static const int TABLEBASE_WIN_SCORE = WIN_SCORE - 500; // Won by the tablebase, distance unknown
+
+    struct Result {
+        int move = -1;
+        int score = 0;
+        int depth = 0;
+        uint64_t nodes = 0;
+        uint64_t tablebaseHits = 0;
+    };
+
+    // threads: 0 - one per core
+    LazySmpSearch(const GridGame& game, unsigned threads, size_t hashMegabytes, bool useHugePages);
+
+    Result search(const GridPosition& position, int depth);
+    void clear() { table.clear(); } // Forget the previous game
+
+    // Leaves are probed in the tablebase instead of evaluated; false if it is for another board
+    bool setTablebase(const BlockTablebaseFile* tablebase);
+
+    unsigned threadCount() const { return threads; }
+    const TranspositionTable& transpositionTable() const { return table; }
+
+private:
+    struct Worker {
+        unsigned index = 0;
+        uint64_t nodes = 0;
+        uint64_t tablebaseHits = 0;
+    };
+
+    const GridGame& game;
+    unsigned threads;
+    TranspositionTable table;
+    const BlockTablebaseFile* tablebase = nullptr;
+    std::vector<uint64_t> zobrist; // Two keys per cell, X and O
+    std::vector<int> moveOrder;    // Centre cells first
+    std::atomic<bool> isStopping{ false };
+    std::atomic<bool> hasResult{ false };
+    Result result;
+
+    void runWorker(Worker& worker, const GridPosition& root, int targetDepth);
+    int searchRoot(Worker& worker, const GridPosition& root, uint64_t key, int depth, int& bestMove);
+    int negamax(Worker& worker, const GridPosition& position, uint64_t key, int lastCell, int depth, int ply, int alpha, int beta);
+    int evaluate(const GridPosition& position) const;
+    uint64_t keyOf(const GridPosition& position) const;
+    uint64_t moveKey(const GridPosition& position, int cell) const;
+};
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef LISTENERS_H
+#define LISTENERS_H
+
+#include <cstdint>
+#include <string>
+
+// Non-blocking listening sockets. Return the fd, or -1 after printing the error
+int openTcpListener(uint16_t port);
+int openUnixListener(const std::string& path);
+
+// Accepts one pending client as a non-blocking socket. Returns -1 when there is none left
+int acceptClient(int listenFd);
+
+#endif
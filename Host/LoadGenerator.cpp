@@ -0,0 +1,167 @@
+// Load generator for host_server: every connection plays Man vs Man games as fast
+// as the server answers. A game is pipelined in one write and ends with "X Wins",
+// so each game costs one round trip and seven Move commands.
+// Before and after the run the server's IoStats are read to report its syscalls per move.
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static const char GAME_SCRIPT[] =
+    "StartGame\nSetMode 1\nMove 1\nMove 2\nMove 3\nMove 4\nMove 5\nMove 6\nMove 7\n";
+static const int MOVES_PER_GAME = 7;
+
+static int connectTo(const std::string& address) {
+    int fd;
+    if (address.rfind("unix:", 0) == 0) {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un target = {};
+        target.sun_family = AF_UNIX;
+        strncpy(target.sun_path, address.c_str() + 5, sizeof(target.sun_path) - 1);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&target), sizeof(target)) < 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    size_t colon = address.rfind(':');
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in target = {};
+    target.sin_family = AF_INET;
+    target.sin_port = htons(static_cast<uint16_t>(atoi(address.c_str() + colon + 1)));
+    inet_pton(AF_INET, address.substr(0, colon).c_str(), &target.sin_addr);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&target), sizeof(target)) < 0) {
+        close(fd);
+        return -1;
+    }
+    int enable = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    return fd;
+}
+
+// Plays one game on a blocking connection; false if the server went away
+static bool playGame(int fd, std::string& buffer) {
+    if (send(fd, GAME_SCRIPT, sizeof(GAME_SCRIPT) - 1, MSG_NOSIGNAL) < 0) {
+        return false;
+    }
+    buffer.clear();
+    char chunk[4096];
+    while (buffer.find("X Wins") == std::string::npos) {
+        ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+        if (received <= 0) {
+            return false;
+        }
+        buffer.append(chunk, received);
+    }
+    return true;
+}
+
+struct IoStats {
+    std::string backend;
+    uint64_t syscalls = 0;
+    bool isValid = false;
+};
+
+// IoStats backend=<epoll|uring> syscalls=<n> commands=<n>. Each query is answered by
+// one shard only, so the figure is meaningful for an unsharded server
+static IoStats queryIoStats(const std::string& address) {
+    IoStats stats;
+    int fd = connectTo(address);
+    if (fd < 0) {
+        return stats;
+    }
+    std::string reply;
+    char chunk[256];
+    if (send(fd, "IoStats\n", 8, MSG_NOSIGNAL) == 8) {
+        ssize_t received;
+        while (reply.find('\n') == std::string::npos && (received = recv(fd, chunk, sizeof(chunk), 0)) > 0) {
+            reply.append(chunk, received);
+        }
+    }
+    close(fd);
+
+    size_t backend = reply.find("backend=");
+    size_t syscalls = reply.find("syscalls=");
+    if (reply.rfind("IoStats", 0) == 0 && backend != std::string::npos && syscalls != std::string::npos) {
+        stats.backend = reply.substr(backend + 8, reply.find(' ', backend) - backend - 8);
+        stats.syscalls = strtoull(reply.c_str() + syscalls + 9, nullptr, 10);
+        stats.isValid = true;
+    }
+    return stats;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <host:port|unix:path> [threads] [connections per thread] [seconds]" << std::endl;
+        return 1;
+    }
+    std::string address = argv[1];
+    int threadCount = (argc > 2) ? atoi(argv[2]) : 4;
+    int connectionsPerThread = (argc > 3) ? atoi(argv[3]) : 16;
+    int seconds = (argc > 4) ? atoi(argv[4]) : 5;
+
+    std::atomic<uint64_t> games{ 0 };
+    std::atomic<bool> isStopping{ false };
+    std::vector<std::thread> threads;
+    IoStats statsBefore = queryIoStats(address);
+
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&]() {
+            std::vector<int> fds;
+            for (int c = 0; c < connectionsPerThread; c++) {
+                int fd = connectTo(address);
+                if (fd < 0) {
+                    std::cerr << "Failed to connect to " << address << std::endl;
+                    break;
+                }
+                fds.push_back(fd);
+            }
+
+            std::string buffer;
+            while (!isStopping && !fds.empty()) {
+                for (int fd : fds) {
+                    if (!playGame(fd, buffer)) {
+                        isStopping = true;
+                        break;
+                    }
+                    games++;
+                }
+            }
+            for (int fd : fds) {
+                close(fd);
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    isStopping = true;
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    IoStats statsAfter = queryIoStats(address);
+
+    std::cout << "connections: " << threadCount * connectionsPerThread
+              << ", games/s: " << static_cast<uint64_t>(games / elapsed)
+              << ", moves/s: " << static_cast<uint64_t>(games * MOVES_PER_GAME / elapsed);
+    if (statsBefore.isValid && statsAfter.isValid && games > 0) {
+        std::cout << ", " << statsAfter.backend << " syscalls/move: "
+                  << static_cast<double>(statsAfter.syscalls - statsBefore.syscalls) / (games * MOVES_PER_GAME);
+    }
+    std::cout << std::endl;
+    return 0;
+}
@@ -0,0 +1,241 @@
+// Regression harness for the engine in GameCore.h.
+// perft walks the whole game tree from a position with isPositionValid(), checkWin() and
+// isBoardFull() and counts positions, finished games, wins and draws at every depth; from
+// the empty board the totals must match the known 3x3 numbers. Then minimax() and
+// bestMove() are checked on every position reachable from the empty board against an
+// independent reference solver written on a plain char board.
+// Exits with 1 on any difference, so it can gate engine changes.
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "GameCore.h"
+
+struct DepthCounts {
+    uint64_t positions = 0;
+    uint64_t games = 0; // Games that ended at this depth
+    uint64_t xWins = 0;
+    uint64_t oWins = 0;
+    uint64_t draws = 0;
+};
+
+static void perft(uint32_t cells, int depth, std::vector<DepthCounts>& counts) {
+    DepthCounts& count = counts[depth];
+    count.positions++;
+    if (checkWin(cells, PLAYER_X) || checkWin(cells, PLAYER_O) || isBoardFull(cells)) {
+        count.games++;
+        count.xWins += checkWin(cells, PLAYER_X);
+        count.oWins += checkWin(cells, PLAYER_O);
+        count.draws += !checkWin(cells, PLAYER_X) && !checkWin(cells, PLAYER_O);
+        return;
+    }
+    uint8_t piece = pieceOf(sideToMove(cells));
+    for (int position = 1; position <= CELL_COUNT; position++) {
+        if (isPositionValid(cells, position)) {
+            perft(withCell(cells, position - 1, piece), depth + 1, counts);
+        }
+    }
+}
+
+const int8_t UNKNOWN = -128;
+
+// Reference solver: value for the side to move in minimax() units, 10 - plies to a win,
+// plies - 10 to a loss, 0 for a draw; memoized by the base-3 index
+class ReferenceSolver {
+public:
+    ReferenceSolver() : values(POSITION_COUNT, UNKNOWN) {}
+
+    int value(const char board[CELL_COUNT]) {
+        int index = 0;
+        for (int k = CELL_COUNT - 1; k >= 0; k--) {
+            index = index * 3 + (board[k] == 'X' ? 1 : board[k] == 'O' ? 2 : 0);
+        }
+        if (values[index] != UNKNOWN) {
+            return values[index];
+        }
+
+        int xCount = 0;
+        int oCount = 0;
+        for (int k = 0; k < CELL_COUNT; k++) {
+            xCount += (board[k] == 'X');
+            oCount += (board[k] == 'O');
+        }
+        char mover = (xCount == oCount) ? 'X' : 'O';
+        char lastMover = (mover == 'X') ? 'O' : 'X';
+        int result;
+        if (hasLine(board, lastMover)) {
+            result = -10;
+        } else if (xCount + oCount == CELL_COUNT) {
+            result = 0;
+        } else {
+            result = -100;
+            for (int k = 0; k < CELL_COUNT; k++) {
+                if (board[k] != ' ') {
+                    continue;
+                }
+                char child[CELL_COUNT];
+                memcpy(child, board, CELL_COUNT);
+                child[k] = mover;
+                // One ply further away: wins and losses move one step towards 0
+                int score = -value(child);
+                score += (score > 0) ? -1 : (score < 0) ? 1 : 0;
+                if (score > result) {
+                    result = score;
+                }
+            }
+        }
+        values[index] = static_cast<int8_t>(result);
+        return result;
+    }
+
+private:
+    std::vector<int8_t> values;
+
+    static bool hasLine(const char board[CELL_COUNT], char player) {
+        static const int LINES[8][3] = {
+            { 0, 1, 2 }, { 3, 4, 5 }, { 6, 7, 8 },
+            { 0, 3, 6 }, { 1, 4, 7 }, { 2, 5, 8 },
+            { 0, 4, 8 }, { 2, 4, 6 }
+        };
+        for (const int* line : LINES) {
+            if (board[line[0]] == player && board[line[1]] == player && board[line[2]] == player) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+static void toBoard(uint32_t cells, char board[CELL_COUNT]) {
+    for (int k = 0; k < CELL_COUNT; k++) {
+        uint8_t piece = cellAt(cells, k);
+        board[k] = (piece == CELL_X) ? 'X' : (piece == CELL_O) ? 'O' : ' ';
+    }
+}
+
+// Every position reachable from the empty board, each once
+static void collectPositions(uint32_t cells, std::vector<bool>& isSeen, std::vector<uint32_t>& positions) {
+    uint16_t index = positionIndex(cells);
+    if (isSeen[index]) {
+        return;
+    }
+    isSeen[index] = true;
+    positions.push_back(cells);
+    if (isGameOver(cells)) {
+        return;
+    }
+    uint8_t piece = pieceOf(sideToMove(cells));
+    for (int k = 0; k < CELL_COUNT; k++) {
+        if (cellAt(cells, k) == CELL_EMPTY) {
+            collectPositions(withCell(cells, k, piece), isSeen, positions);
+        }
+    }
+}
+
+// minimax() of every reply and the move of bestMove() must match the reference.
+// bestMove() keeps the first of equally good moves
+static int checkSearch(uint64_t& searched) {
+    std::vector<bool> isSeen(POSITION_COUNT, false);
+    std::vector<uint32_t> positions;
+    collectPositions(EMPTY_BOARD, isSeen, positions);
+
+    ReferenceSolver reference;
+    int failures = 0;
+    for (uint32_t cells : positions) {
+        if (isGameOver(cells)) {
+            continue;
+        }
+        searched++;
+        char player = sideToMove(cells);
+        int expectedMove = -1;
+        int expectedScore = -1000;
+        for (int k = 0; k < CELL_COUNT; k++) {
+            if (cellAt(cells, k) != CELL_EMPTY) {
+                continue;
+            }
+            uint32_t child = withCell(cells, k, pieceOf(player));
+            char board[CELL_COUNT];
+            toBoard(child, board);
+            int score = -reference.value(board);
+            int engineScore = minimax(child, opponent(player), player, 0);
+            if (engineScore != score && failures++ < 10) {
+                std::cout << "minimax mismatch at index " << positionIndex(cells) << " move " << k + 1
+                          << ": " << engineScore << ", reference " << score << std::endl;
+            }
+            if (score > expectedScore) {
+                expectedScore = score;
+                expectedMove = k;
+            }
+        }
+
+        int move[2];
+        bestMove(cells, player, move);
+        if (move[0] * BOARD_SIZE + move[1] != expectedMove && failures++ < 10) {
+            std::cout << "bestMove mismatch at index " << positionIndex(cells) << ": " << move[0] * BOARD_SIZE + move[1] + 1
+                      << ", reference " << expectedMove + 1 << std::endl;
+        }
+    }
+    return failures;
+}
+
+int main(int argc, char* argv[]) {
+    // Optional start position in the SetPosition format: "XO3.5.789"
+    uint32_t start = EMPTY_BOARD;
+    if (argc > 1) {
+        if (strlen(argv[1]) != CELL_COUNT) {
+            std::cout << "Usage: " << argv[0] << " [position, 9 chars: X, O or anything else for an empty cell]" << std::endl;
+            return 1;
+        }
+        for (int k = 0; k < CELL_COUNT; k++) {
+            if (argv[1][k] == PLAYER_X || argv[1][k] == PLAYER_O) {
+                start = withCell(start, k, pieceOf(argv[1][k]));
+            }
+        }
+        int difference = countPieces(start, CELL_X) - countPieces(start, CELL_O);
+        if (difference != 0 && difference != 1) {
+            std::cout << "Invalid position: X must have as many marks as O or one more" << std::endl;
+            return 1;
+        }
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<DepthCounts> counts(CELL_COUNT + 1);
+    perft(start, 0, counts);
+    double perftSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    DepthCounts total;
+    std::cout << "depth  positions  games  X wins  O wins  draws" << std::endl;
+    for (int depth = 0; depth <= CELL_COUNT; depth++) {
+        const DepthCounts& count = counts[depth];
+        if (count.positions == 0) {
+            continue;
+        }
+        std::cout << std::setw(5) << depth << std::setw(11) << count.positions << std::setw(7) << count.games
+                  << std::setw(8) << count.xWins << std::setw(8) << count.oWins << std::setw(7) << count.draws << std::endl;
+        total.positions += count.positions;
+        total.games += count.games;
+        total.xWins += count.xWins;
+        total.oWins += count.oWins;
+        total.draws += count.draws;
+    }
+    std::cout << "total" << std::setw(11) << total.positions << std::setw(7) << total.games << std::setw(8) << total.xWins
+              << std::setw(8) << total.oWins << std::setw(7) << total.draws << ", " << perftSeconds * 1000 << " ms" << std::endl;
+
+    int failures = 0;
+    // 255168 games from the empty board: 131184 won by X, 77904 by O, 46080 drawn
+    if (start == EMPTY_BOARD && (total.games != 255168 || total.xWins != 131184 || total.oWins != 77904 || total.draws != 46080)) {
+        std::cout << "perft mismatch: expected 255168 games, 131184/77904/46080" << std::endl;
+        failures++;
+    }
+
+    begin = std::chrono::steady_clock::now();
+    uint64_t searched = 0;
+    failures += checkSearch(searched);
+    double searchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << searched << " reachable positions searched, " << failures << " mismatches, "
+              << searchSeconds * 1000 << " ms" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+// Solves every legal position of an N×N board backwards, from full boards to the
+// empty one. Positions are grouped into layers by the number of marks; a layer only
+// depends on the next one, so all positions of a layer are solved in parallel.
+// Values are kept as 2-bit win/draw/loss entries over the base-3 index and written as
+// a tablebase file (Tablebase.h). Reports states per second and peak memory.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "GridBoard.h"
+#include "Tablebase.h"
+
+class RetrogradeSolver {
+public:
+    RetrogradeSolver(const GridGame& game, unsigned threads)
+        : game(game), threads(threads), entryCount(game.indexCount()), words((entryCount + 31) / 32), powers(game.cellCount()) {
+        uint64_t power = 1;
+        for (int cell = 0; cell < game.cellCount(); cell++) {
+            powers[cell] = power;
+            power *= 3;
+        }
+    }
+
+    // Returns the number of legal positions per layer
+    std::vector<uint64_t> solve() {
+        std::vector<uint64_t> layerSizes(game.cellCount() + 1);
+        for (int marks = game.cellCount(); marks >= 0; marks--) {
+            layerXSets = subsetsOfSize(game.cellMask(), (marks + 1) / 2);
+            nextXSet = 0;
+            std::atomic<uint64_t> solved{ 0 };
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threads; t++) {
+                workers.emplace_back([this, marks, &solved]() { solved += solveLayer(marks / 2); });
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+            layerSizes[marks] = solved;
+        }
+        return layerSizes;
+    }
+
+    uint8_t value(uint64_t index) const {
+        return (words[index >> 5].load(std::memory_order_relaxed) >> (2 * (index & 31))) & 3;
+    }
+
+    // Packed four entries per byte, the tablebase file layout (little-endian words)
+    std::vector<uint8_t> packedBytes() const {
+        std::vector<uint8_t> bytes((entryCount + 3) / 4);
+        for (size_t i = 0; i < bytes.size(); i++) {
+            bytes[i] = static_cast<uint8_t>(words[i / 8].load(std::memory_order_relaxed) >> (8 * (i % 8)));
+        }
+        return bytes;
+    }
+
+private:
+    const GridGame& game;
+    unsigned threads;
+    uint64_t entryCount;
+    std::vector<std::atomic<uint64_t>> words; // 32 values per word, written with fetch_or
+    std::vector<uint64_t> powers;
+    std::vector<uint64_t> layerXSets;         // Every placement of X's marks in this layer
+    std::atomic<size_t> nextXSet{ 0 };
+
+    static std::vector<uint64_t> subsetsOfSize(uint64_t cells, int size) {
+        std::vector<uint64_t> subsets;
+        for (uint64_t subset = cells; ; subset = (subset - 1) & cells) {
+            if (__builtin_popcountll(subset) == size) {
+                subsets.push_back(subset);
+            }
+            if (subset == 0) {
+                return subsets;
+            }
+        }
+    }
+
+    // Sum of 3^cell over the set cells
+    uint64_t ternary(uint64_t cells) const {
+        uint64_t sum = 0;
+        while (cells) {
+            sum += powers[__builtin_ctzll(cells)];
+            cells &= cells - 1;
+        }
+        return sum;
+    }
+
+    // Threads take X placements one at a time and solve every O placement next to them
+    uint64_t solveLayer(int oCount) {
+        uint64_t solved = 0;
+        size_t taken;
+        while ((taken = nextXSet.fetch_add(1)) < layerXSets.size()) {
+            GridPosition position;
+            position.x = layerXSets[taken];
+            uint64_t xIndex = ternary(position.x);
+            uint64_t free = game.cellMask() & ~position.x;
+            for (uint64_t o = free; ; o = (o - 1) & free) {
+                if (__builtin_popcountll(o) == oCount) {
+                    position.o = o;
+                    uint64_t index = xIndex + 2 * ternary(o);
+                    uint8_t result = solvePosition(position, index);
+                    if (result != WDL_ILLEGAL) {
+                        words[index >> 5].fetch_or(static_cast<uint64_t>(result) << (2 * (index & 31)), std::memory_order_relaxed);
+                        solved++;
+                    }
+                }
+                if (o == 0) {
+                    break;
+                }
+            }
+        }
+        return solved;
+    }
+
+    // Children are in the next layer, which is already solved
+    uint8_t solvePosition(const GridPosition& position, uint64_t index) const {
+        bool isXToMove = GridGame::isXToMove(position);
+        uint64_t mover = isXToMove ? position.x : position.o;
+        uint64_t lastMover = isXToMove ? position.o : position.x;
+        if (game.isWin(mover)) {
+            return WDL_ILLEGAL; // The game was over before this move
+        }
+        if (game.isWin(lastMover)) {
+            return WDL_LOSS;
+        }
+        uint64_t empty = game.emptyCells(position);
+        if (empty == 0) {
+            return WDL_DRAW;
+        }
+
+        bool canDraw = false;
+        for (int cell = 0; cell < game.cellCount(); cell++) {
+            if (!(empty & (1ull << cell))) {
+                continue;
+            }
+            uint8_t child = value(index + powers[cell] * (isXToMove ? 1 : 2));
+            if (child == WDL_LOSS) {
+                return WDL_WIN;
+            }
+            canDraw |= (child == WDL_DRAW);
+        }
+        return canDraw ? WDL_DRAW : WDL_LOSS;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    int size = (argc > 1) ? atoi(argv[1]) : 4;
+    int winLength = (argc > 2) ? atoi(argv[2]) : size;
+    unsigned threads = (argc > 3) ? static_cast<unsigned>(atoi(argv[3])) : 0;
+    std::string output = (argc > 4) ? argv[4] : "tablebase_" + std::to_string(size) + "x" + std::to_string(size) + ".bin";
+    if (size < 2 || size > 4 || winLength < 2 || winLength > size) {
+        std::cout << "Usage: " << argv[0] << " [size 2..4] [win length] [threads, 0 - one per core] [output file]" << std::endl;
+        return 1;
+    }
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    GridGame game(size, winLength);
+    auto start = std::chrono::steady_clock::now();
+    RetrogradeSolver solver(game, threads);
+    std::vector<uint64_t> layerSizes = solver.solve();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t legal = 0;
+    for (uint64_t layerSize : layerSizes) {
+        legal += layerSize;
+    }
+
+    TablebaseHeader header = { { 'T', 'T', 'T', 'B' }, TABLEBASE_VERSION,
+        static_cast<uint8_t>(size), static_cast<uint8_t>(winLength), 0, game.indexCount() };
+    std::vector<uint8_t> bytes = solver.packedBytes();
+    FILE* file = fopen(output.c_str(), "wb");
+    if (file == nullptr
+        || fwrite(&header, sizeof(header), 1, file) != 1
+        || fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size()) {
+        std::cerr << "Failed to write " << output << std::endl;
+        if (file) {
+            fclose(file);
+        }
+        return 1;
+    }
+    fclose(file);
+
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    const char* values[] = { "illegal", "first player wins", "second player wins", "draw" };
+    std::cout << size << "x" << size << ", " << winLength << " in a row: " << values[solver.value(0)] << std::endl;
+    std::cout << "legal positions: " << legal << " of " << game.indexCount()
+              << ", " << threads << " threads, " << seconds << " s, "
+              << static_cast<uint64_t>(legal / seconds) << " states/s" << std::endl;
+    std::cout << "peak memory: " << usage.ru_maxrss / 1024 << " MB, table " << bytes.size() / 1024 << " KB, written to " << output << std::endl;
+    return 0;
+}
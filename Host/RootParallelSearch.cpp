@@ -0,0 +1,51 @@
+#include "RootParallelSearch.h"
+
+#include <atomic>
+#include <thread>
+
+// Each task counts into its own SearchCounters, they are added up at the end
+void rootParallelBestMove(WorkStealingPool& pool, uint32_t cells, char aiPlayer, int move[2], SearchCounters* counters) {
+    int scores[CELL_COUNT];
+    SearchCounters taskCounters[CELL_COUNT] = {};
+    std::atomic<int> remaining{ 0 };
+
+    for (int k = 0; k < CELL_COUNT; k++) {
+        if (cellAt(cells, k) != CELL_EMPTY) {
+            continue;
+        }
+        remaining.fetch_add(1, std::memory_order_relaxed);
+        uint32_t child = withCell(cells, k, pieceOf(aiPlayer));
+        SearchCounters* moveCounters = counters ? &taskCounters[k] : nullptr;
+        pool.submit([child, aiPlayer, k, moveCounters, &scores, &remaining]() {
+            scores[k] = minimax(child, opponent(aiPlayer), aiPlayer, 0, moveCounters);
+            remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (!pool.runPendingTask()) {
+            std::this_thread::yield(); // The last root moves are running on other workers
+        }
+    }
+
+    // Exactly the loop of bestMove(): the first cell with the strictly highest score wins
+    int bestScore = -1000;
+    move[0] = -1;
+    move[1] = -1;
+    for (int k = 0; k < CELL_COUNT; k++) {
+        if (cellAt(cells, k) == CELL_EMPTY && scores[k] > bestScore) {
+            bestScore = scores[k];
+            move[0] = k / BOARD_SIZE;
+            move[1] = k % BOARD_SIZE;
+        }
+    }
+
+    for (int k = 0; counters && k < CELL_COUNT; k++) {
+        counters->nodes += taskCounters[k].nodes;
+        counters->cutoffs += taskCounters[k].cutoffs;
+        counters->ttHits += taskCounters[k].ttHits;
+        if (taskCounters[k].maxDepth > counters->maxDepth) {
+            counters->maxDepth = taskCounters[k].maxDepth;
+        }
+    }
+}
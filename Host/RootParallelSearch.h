@@ -0,0 +1,30 @@
+#ifndef ROOT_PARALLEL_SEARCH_H
+#define ROOT_PARALLEL_SEARCH_H
+
+#include <cstdint>
+
+#include "GameCore.h"
+#include "WorkStealingPool.h"
+
+// How the host computes an AI move: bestMove() on one thread, or one pool task per root move
+enum class RootSearch {
+    Sequential,
+    Parallel
+};
+
+// Same result as bestMove() from GameCore.h, including ties: every root move is
+// scored by its own task on a copy of the board, then the scores are reduced
+// in cell order on the calling thread. The caller helps run the tasks while it waits,
+// so it may itself be a pool task
+void rootParallelBestMove(WorkStealingPool& pool, uint32_t cells, char aiPlayer, int move[2], SearchCounters* counters = nullptr);
+
+inline void searchBestMove(RootSearch mode, WorkStealingPool* pool, uint32_t cells, char aiPlayer, int move[2],
+                           SearchCounters* counters = nullptr) {
+    if (mode == RootSearch::Parallel && pool != nullptr) {
+        rootParallelBestMove(*pool, cells, aiPlayer, move, counters);
+    } else {
+        bestMove(cells, aiPlayer, move, counters);
+    }
+}
+
+#endif
@@ -0,0 +1,30 @@
+#include "SearchConfig.h"
+
+#include <fstream>
+#include <iostream>
+
+#include "json.hpp"
+
+using json = nlohmann::json;
+
+SearchConfig loadSearchConfig(const std::string& filename) {
+    SearchConfig config;
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open configuration file: " << filename << ", using defaults" << std::endl;
+        return config;
+    }
+    try {
+        json j;
+        file >> j;
+        const json& search = j.value("Search", json::object());
+        config.threads = search.value("threads", config.threads);
+        config.hashMegabytes = search.value("hashMegabytes", config.hashMegabytes);
+        config.useHugePages = search.value("hugePages", config.useHugePages);
+        config.tablebaseFile = search.value("tablebase", config.tablebaseFile);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error parsing JSON file: " << e.what() << std::endl;
+    }
+    return config;
+}
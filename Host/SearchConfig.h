@@ -0,0 +1,18 @@
+#ifndef SEARCH_CONFIG_H
+#define SEARCH_CONFIG_H
+
+#include <cstddef>
+#include <string>
+
+// "Search" section of Config/config.json, used by the host-side search tools
+struct SearchConfig {
+    unsigned threads = 0;      // 0 - one per core
+    size_t hashMegabytes = 64; // Shared transposition table
+    bool useHugePages = true;
+    std::string tablebaseFile; // Compressed tablebase probed at the leaves, empty - none
+};
+
+// Missing file or keys keep the defaults
+SearchConfig loadSearchConfig(const std::string& filename);
+
+#endif
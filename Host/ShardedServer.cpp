@@ -0,0 +1,136 @@
+#include "ShardedServer.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include "Listeners.h"
+
+ShardedServer::ShardedServer(unsigned shardCount, IoBackend backend) {
+    if (shardCount == 0) {
+        shardCount = std::thread::hardware_concurrency();
+    }
+    if (shardCount == 0) {
+        shardCount = 1;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    for (unsigned i = 0; i < shardCount; i++) {
+        shards.emplace_back(new GameServer(-1, backend));
+    }
+}
+
+ShardedServer::~ShardedServer() {
+    stop();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    shards.clear();
+    for (int fd : listeners) {
+        close(fd);
+    }
+    for (const std::string& path : unixPaths) {
+        unlink(path.c_str());
+    }
+    close(epollFd);
+}
+
+bool ShardedServer::listenTcp(uint16_t port) {
+    int fd = openTcpListener(port);
+    return fd >= 0 && addListener(fd);
+}
+
+bool ShardedServer::listenUnix(const std::string& path) {
+    int fd = openUnixListener(path);
+    if (fd < 0) {
+        return false;
+    }
+    unixPaths.push_back(path);
+    return addListener(fd);
+}
+
+// Every shard maps the same file, the pages are shared
+bool ShardedServer::openSolvedGames(const std::string& path) {
+    for (auto& shard : shards) {
+        if (!shard->openSolvedGames(path)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ShardedServer::addListener(int fd) {
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        std::cerr << "Failed to register listener: " << strerror(errno) << std::endl;
+        close(fd);
+        return false;
+    }
+    listeners.push_back(fd);
+    return true;
+}
+
+void ShardedServer::run() {
+    unsigned cores = std::thread::hardware_concurrency();
+    for (unsigned i = 0; i < shards.size(); i++) {
+        GameServer* shard = shards[i].get();
+        threads.emplace_back([shard]() { shard->run(); });
+
+        if (cores > 0) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(i % cores, &cpus);
+            pthread_setaffinity_np(threads.back().native_handle(), sizeof(cpus), &cpus);
+        }
+    }
+
+    const int MAX_EVENTS = 64;
+    epoll_event events[MAX_EVENTS];
+
+    while (!isStopRequested) {
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, 1000);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "epoll_wait failed: " << strerror(errno) << std::endl;
+            break;
+        }
+        for (int i = 0; i < count; i++) {
+            dispatch(events[i].data.fd);
+        }
+    }
+}
+
+void ShardedServer::stop() {
+    isStopRequested = true;
+    for (auto& shard : shards) {
+        shard->stop();
+    }
+}
+
+void ShardedServer::dispatch(int listenFd) {
+    int fd;
+    while ((fd = acceptClient(listenFd)) >= 0) {
+        uint64_t gameId = nextGameId++;
+        GameServer& shard = *shards[gameId % shards.size()];
+
+        // A full inbox means the shard is far behind; back off instead of queueing without bound
+        int attempts = 0;
+        while (!shard.offerConnection(fd, gameId)) {
+            if (++attempts == 1000) {
+                std::cerr << "Shard inbox is full, dropping game " << gameId << std::endl;
+                close(fd);
+                break;
+            }
+            sched_yield();
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef SHARDED_SERVER_H
+#define SHARDED_SERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GameServer.h"
+
+// Shared-nothing variant of the host server. Each shard is a GameServer with its
+// own event loop, sessions and connections, running on a thread pinned to one core.
+// The acceptor (the thread calling run()) numbers games in arrival order and hands
+// game N to shard N % shardCount through that shard's SPSC inbox; that is the only
+// data that crosses threads. AI moves are searched inline on the owning shard.
+class ShardedServer {
+public:
+    // 0 shards means one per core
+    explicit ShardedServer(unsigned shardCount = 0, IoBackend backend = IoBackend::Epoll);
+    ~ShardedServer();
+
+    bool listenTcp(uint16_t port);
+    bool listenUnix(const std::string& path);
+    bool openSolvedGames(const std::string& path);
+    void run();
+    void stop();
+
+    unsigned shardCount() const { return static_cast<unsigned>(shards.size()); }
+
+private:
+    int epollFd = -1;
+    std::atomic<bool> isStopRequested{ false };
+    uint64_t nextGameId = 1;
+    std::vector<int> listeners;
+    std::vector<std::string> unixPaths;
+    std::vector<std::unique_ptr<GameServer>> shards;
+    std::vector<std::thread> threads;
+
+    bool addListener(int fd);
+    void dispatch(int fd);
+};
+
+#endif
@@ -0,0 +1,87 @@
+// Scaling of the Lazy SMP search on an N×N board: time to reach a fixed depth from
+// a few opening positions with 1, 2, 4, ... threads up to the "threads" setting in
+// config.json. Efficiency is the speedup over one thread divided by the thread count.
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GridBoard.h"
+#include "LazySmpSearch.h"
+#include "SearchConfig.h"
+
+// The empty board and the replies to the centre and corner openings
+static std::vector<GridPosition> openingPositions(const GridGame& game) {
+    int size = game.size();
+    int centre = (size / 2) * size + size / 2;
+    std::vector<GridPosition> positions(1);
+    for (int opening : { centre, 0 }) {
+        GridPosition afterX = GridGame::withMove(GridPosition(), opening);
+        positions.push_back(afterX);
+        positions.push_back(GridGame::withMove(afterX, opening == 0 ? centre : 0));
+    }
+    return positions;
+}
+
+int main(int argc, char* argv[]) {
+    std::string configPath = (argc > 1) ? argv[1] : "../Config/config.json";
+    int size = (argc > 2) ? atoi(argv[2]) : 5;
+    int winLength = (argc > 3) ? atoi(argv[3]) : 4;
+    int depth = (argc > 4) ? atoi(argv[4]) : 8;
+    if (size < 2 || size > MAX_GRID_SIZE || winLength < 2 || winLength > size) {
+        std::cout << "Usage: " << argv[0] << " [config.json] [size 2..8] [win length] [depth]" << std::endl;
+        return 1;
+    }
+
+    SearchConfig config = loadSearchConfig(configPath);
+    unsigned maxThreads = config.threads ? config.threads : std::max(1u, std::thread::hardware_concurrency());
+
+    GridGame game(size, winLength);
+    std::vector<GridPosition> positions = openingPositions(game);
+    BlockTablebaseFile tablebase;
+    bool hasTablebase = !config.tablebaseFile.empty() && tablebase.open(config.tablebaseFile)
+        && tablebase.boardSize() == size && tablebase.winLength() == winLength;
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    std::cout << size << "x" << size << ", " << winLength << " in a row, depth " << depth
+              << ", " << config.hashMegabytes << " MB table"
+              << (hasTablebase ? ", leaves probed in " + config.tablebaseFile : "") << std::endl;
+    std::cout << "threads  seconds  nodes/s     speedup  efficiency  moves" << std::endl;
+    double singleThreadSeconds = 0;
+    for (unsigned threads : threadCounts) {
+        LazySmpSearch search(game, threads, config.hashMegabytes, config.useHugePages);
+        search.setTablebase(hasTablebase ? &tablebase : nullptr);
+        std::string moves;
+        uint64_t nodes = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (const GridPosition& position : positions) {
+            search.clear();
+            LazySmpSearch::Result result = search.search(position, depth);
+            nodes += result.nodes;
+            moves += std::to_string(result.move) + " ";
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (threads == 1) {
+            singleThreadSeconds = seconds;
+            std::cout << "(table on " << (search.transpositionTable().isOnHugePages() ? "huge pages" : "regular pages") << ")" << std::endl;
+        }
+        double speedup = singleThreadSeconds / seconds;
+        std::cout << std::setw(7) << threads << "  "
+                  << std::setw(7) << std::fixed << std::setprecision(3) << seconds << "  "
+                  << std::setw(10) << std::setprecision(0) << nodes / seconds << "  "
+                  << std::setw(7) << std::setprecision(2) << speedup << "  "
+                  << std::setw(9) << std::setprecision(0) << 100.0 * speedup / threads << "%  "
+                  << moves << std::endl;
+    }
+    return 0;
+}
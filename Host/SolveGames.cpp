@@ -0,0 +1,142 @@
+// Solves every position reachable from the empty N×N board and writes the
+// solved games file (see SolvedGameFile.h): value for the side to move and the
+// best move, the quickest win or the longest defence, for each base-3 index.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GridBoard.h"
+#include "SolvedGameFile.h"
+
+class Solver {
+public:
+    explicit Solver(const GridGame& game)
+        : game(game), entries(game.indexCount(), 0), distances(game.indexCount(), 0), powers(game.cellCount()) {
+        uint64_t power = 1;
+        for (int cell = 0; cell < game.cellCount(); cell++) {
+            powers[cell] = power;
+            power *= 3;
+        }
+    }
+
+    void solveAll() {
+        solve(GridPosition(), 0, -1);
+    }
+
+    const std::vector<uint8_t>& solvedEntries() const { return entries; }
+
+    uint64_t solvedCount() const {
+        uint64_t count = 0;
+        for (uint8_t entry : entries) {
+            count += (entry != 0);
+        }
+        return count;
+    }
+
+private:
+    const GridGame& game;
+    std::vector<uint8_t> entries;   // Packed SolvedGameFile entries, 0 - not solved yet
+    std::vector<uint8_t> distances; // Moves until the game ends with perfect play
+    std::vector<uint64_t> powers;
+
+    SolvedGameFile::Entry solve(const GridPosition& position, uint64_t index, int lastCell) {
+        SolvedGameFile::Entry result;
+        if (entries[index] != 0) {
+            result.value = static_cast<SolvedGameFile::Value>(entries[index] & 3);
+            result.bestMove = (entries[index] >> 2) - 1;
+            return result;
+        }
+
+        bool isXToMove = GridGame::isXToMove(position);
+        uint64_t lastMover = isXToMove ? position.o : position.x;
+        uint64_t empty = game.emptyCells(position);
+        if (lastCell >= 0 && game.isWinThrough(lastMover, lastCell)) {
+            result.value = SolvedGameFile::VALUE_LOSS;
+        } else if (empty == 0) {
+            result.value = SolvedGameFile::VALUE_DRAW;
+        } else {
+            int bestDistance = 0;
+            for (int cell = 0; cell < game.cellCount(); cell++) {
+                if (!(empty & (1ull << cell))) {
+                    continue;
+                }
+                uint64_t childIndex = index + powers[cell] * (isXToMove ? 1 : 2);
+                SolvedGameFile::Value childValue = solve(GridGame::withMove(position, cell), childIndex, cell).value;
+                int distance = distances[childIndex] + 1;
+
+                // The child's value is for the opponent
+                SolvedGameFile::Value value = (childValue == SolvedGameFile::VALUE_LOSS) ? SolvedGameFile::VALUE_WIN
+                    : (childValue == SolvedGameFile::VALUE_WIN) ? SolvedGameFile::VALUE_LOSS : SolvedGameFile::VALUE_DRAW;
+                if (result.bestMove < 0 || isBetter(value, distance, result.value, bestDistance)) {
+                    result.value = value;
+                    result.bestMove = cell;
+                    bestDistance = distance;
+                }
+            }
+            distances[index] = static_cast<uint8_t>(bestDistance);
+        }
+
+        entries[index] = SolvedGameFile::pack(result);
+        return result;
+    }
+
+    // Win beats draw beats loss; the quicker win, the slower loss
+    static bool isBetter(SolvedGameFile::Value value, int distance, SolvedGameFile::Value best, int bestDistance) {
+        auto rank = [](SolvedGameFile::Value v) {
+            return v == SolvedGameFile::VALUE_WIN ? 2 : v == SolvedGameFile::VALUE_DRAW ? 1 : 0;
+        };
+        if (rank(value) != rank(best)) {
+            return rank(value) > rank(best);
+        }
+        if (value == SolvedGameFile::VALUE_WIN) {
+            return distance < bestDistance;
+        }
+        if (value == SolvedGameFile::VALUE_LOSS) {
+            return distance > bestDistance;
+        }
+        return false;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    int size = (argc > 1) ? atoi(argv[1]) : 3;
+    int winLength = (argc > 2) ? atoi(argv[2]) : size;
+    std::string output = (argc > 3) ? argv[3] : "solved_" + std::to_string(size) + "x" + std::to_string(size) + ".bin";
+    // 3^16 one-byte entries is the largest table that fits comfortably in memory
+    if (size < 2 || size > 4 || winLength < 2 || winLength > size) {
+        std::cout << "Usage: " << argv[0] << " [size 2..4] [win length] [output file]" << std::endl;
+        return 1;
+    }
+
+    GridGame game(size, winLength);
+    auto start = std::chrono::steady_clock::now();
+    Solver solver(game);
+    solver.solveAll();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    SolvedFileHeader header = { { 'T', 'T', 'T', 'S' }, SolvedGameFile::VERSION,
+        static_cast<uint8_t>(size), static_cast<uint8_t>(winLength), 0, game.indexCount() };
+    FILE* file = fopen(output.c_str(), "wb");
+    const std::vector<uint8_t>& entries = solver.solvedEntries();
+    if (file == nullptr
+        || fwrite(&header, sizeof(header), 1, file) != 1
+        || fwrite(entries.data(), 1, entries.size(), file) != entries.size()) {
+        std::cerr << "Failed to write " << output << std::endl;
+        if (file) {
+            fclose(file);
+        }
+        return 1;
+    }
+    fclose(file);
+
+    const char* values[] = { "unknown", "first player wins", "second player wins", "draw" };
+    uint8_t root = entries[0];
+    std::cout << size << "x" << size << ", " << winLength << " in a row: " << values[root & 3]
+              << ", " << solver.solvedCount() << " reachable positions solved in " << seconds << " s, "
+              << "written to " << output << std::endl;
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "SolvedGameFile.h"
+
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SolvedGameFile::~SolvedGameFile() {
+    close();
+}
+
+static bool isHeaderValid(const SolvedFileHeader* header, size_t size) {
+    return size >= sizeof(SolvedFileHeader)
+        && memcmp(header->magic, "TTTS", 4) == 0
+        && header->version == SolvedGameFile::VERSION
+        && size - sizeof(SolvedFileHeader) >= header->entryCount;
+}
+
+#ifdef _WIN32
+
+bool SolvedGameFile::open(const std::string& path) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "Failed to open solved games file: " << path << std::endl;
+        return false;
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = GetFileSizeEx(file, &size) ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (view == NULL || !isHeaderValid(static_cast<const SolvedFileHeader*>(view), static_cast<size_t>(size.QuadPart))) {
+        std::cerr << "Invalid solved games file: " << path << std::endl;
+        if (view) {
+            UnmapViewOfFile(view);
+        }
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    mappedBytes = static_cast<size_t>(size.QuadPart);
+    header = static_cast<const SolvedFileHeader*>(view);
+    entries = reinterpret_cast<const uint8_t*>(header + 1);
+    return true;
+}
+
+void SolvedGameFile::close() {
+    if (header) {
+        UnmapViewOfFile(header);
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+    }
+    header = nullptr;
+    entries = nullptr;
+    mappedBytes = 0;
+}
+
+#else
+
+bool SolvedGameFile::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Failed to open solved games file: " << path << std::endl;
+        return false;
+    }
+    struct stat status;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &status) == 0 && status.st_size > 0) {
+        view = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd); // The mapping keeps the file alive
+    if (view == MAP_FAILED || !isHeaderValid(static_cast<const SolvedFileHeader*>(view), status.st_size)) {
+        std::cerr << "Invalid solved games file: " << path << std::endl;
+        if (view != MAP_FAILED) {
+            munmap(view, status.st_size);
+        }
+        return false;
+    }
+
+    mappedBytes = status.st_size;
+    header = static_cast<const SolvedFileHeader*>(view);
+    entries = reinterpret_cast<const uint8_t*>(header + 1);
+    return true;
+}
+
+void SolvedGameFile::close() {
+    if (header) {
+        munmap(const_cast<SolvedFileHeader*>(header), mappedBytes);
+    }
+    header = nullptr;
+    entries = nullptr;
+    mappedBytes = 0;
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef SOLVED_GAME_FILE_H
+#define SOLVED_GAME_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Perfect-play value and best move of every board, written by solve_games and
+// mapped read-only by the client and host_server. A 16-byte header is followed by one
+// byte per base-3 position index (positionIndex() / GridGame::indexOf()):
+// bits 0-1 value for the side to move, bits 2-7 best cell + 1 (0 - game over)
+struct SolvedFileHeader {
+    char magic[4];       // "TTTS"
+    uint8_t version;
+    uint8_t boardSize;
+    uint8_t winLength;
+    uint8_t reserved;
+    uint64_t entryCount; // 3^(boardSize²)
+};
+
+class SolvedGameFile {
+public:
+    enum Value : uint8_t {
+        VALUE_UNKNOWN = 0, // Not reachable from the empty board
+        VALUE_WIN,
+        VALUE_LOSS,
+        VALUE_DRAW
+    };
+
+    struct Entry {
+        Value value = VALUE_UNKNOWN;
+        int bestMove = -1; // Cell 0..N²-1
+    };
+
+    static const uint8_t VERSION = 1;
+
+    SolvedGameFile() = default;
+    ~SolvedGameFile();
+
+    SolvedGameFile(const SolvedGameFile&) = delete;
+    SolvedGameFile& operator=(const SolvedGameFile&) = delete;
+
+    // Maps the file; nothing is parsed besides the header, and the pages are shared between processes
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return header != nullptr; }
+    int boardSize() const { return header ? header->boardSize : 0; }
+    int winLength() const { return header ? header->winLength : 0; }
+
+    Entry lookup(uint64_t index) const {
+        Entry entry;
+        if (header == nullptr || index >= header->entryCount) {
+            return entry;
+        }
+        uint8_t packed = entries[index];
+        entry.value = static_cast<Value>(packed & 3);
+        entry.bestMove = (packed >> 2) - 1;
+        return entry;
+    }
+
+    static uint8_t pack(const Entry& entry) {
+        return static_cast<uint8_t>(entry.value | ((entry.bestMove + 1) << 2));
+    }
+
+private:
+    const SolvedFileHeader* header = nullptr;
+    const uint8_t* entries = nullptr;
+    size_t mappedBytes = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+#endif
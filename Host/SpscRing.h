@@ -0,0 +1,53 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+
+// Lock-free ring buffer for exactly one producer thread and one consumer thread.
+// Each side keeps a cached copy of the other side's index, so the shared
+// cache lines are only touched when the ring looks full or empty.
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer thread only. Returns false if the ring is full
+    bool push(const T& item) {
+        size_t write = writeIndex.load(std::memory_order_relaxed);
+        if (write - cachedReadIndex == Capacity) {
+            cachedReadIndex = readIndex.load(std::memory_order_acquire);
+            if (write - cachedReadIndex == Capacity) {
+                return false;
+            }
+        }
+        slots[write & (Capacity - 1)] = item;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only. Returns false if the ring is empty
+    bool pop(T& item) {
+        size_t read = readIndex.load(std::memory_order_relaxed);
+        if (read == cachedWriteIndex) {
+            cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+            if (read == cachedWriteIndex) {
+                return false;
+            }
+        }
+        item = slots[read & (Capacity - 1)];
+        readIndex.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static const size_t CACHE_LINE = 64;
+
+    alignas(CACHE_LINE) std::atomic<size_t> writeIndex{ 0 };
+    size_t cachedReadIndex = 0;  // Producer's view of readIndex
+    alignas(CACHE_LINE) std::atomic<size_t> readIndex{ 0 };
+    size_t cachedWriteIndex = 0; // Consumer's view of writeIndex
+    alignas(CACHE_LINE) T slots[Capacity];
+};
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include <cstdint>
+
+// Win/draw/loss tablebase written by retrograde_solver: a 16-byte header, then
+// 2-bit values packed four to a byte in base-3 index order (positionIndex() /
+// GridGame::indexOf()), index k in bits 2*(k%4) of byte k/4.
+// Values are for the side to move and use the numbering of SolvedGameFile::Value
+const uint8_t WDL_ILLEGAL = 0; // Impossible piece counts, or the game ended earlier
+const uint8_t WDL_WIN = 1;
+const uint8_t WDL_LOSS = 2;
+const uint8_t WDL_DRAW = 3;
+
+struct TablebaseHeader {
+    char magic[4];       // "TTTB"
+    uint8_t version;
+    uint8_t boardSize;
+    uint8_t winLength;
+    uint8_t reserved;
+    uint64_t entryCount; // 3^(boardSize²)
+};
+
+const uint8_t TABLEBASE_VERSION = 1;
+
+inline uint8_t packedValue(const uint8_t* packed, uint64_t index) {
+    return (packed[index >> 2] >> (2 * (index & 3))) & 3;
+}
+
+#endif
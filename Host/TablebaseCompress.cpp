@@ -0,0 +1,204 @@
+// Converts a retrograde_solver tablebase into the compressed block format of
+// BlockTablebase.h, checks every legal entry against the source and reports the
+// size and probe speed. Optionally writes the table as a PROGMEM array for the sketch.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "BlockTablebase.h"
+#include "Tablebase.h"
+
+static bool readTablebase(const std::string& path, TablebaseHeader& header, std::vector<uint8_t>& packed) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool isValid = fread(&header, sizeof(header), 1, file) == 1
+        && memcmp(header.magic, "TTTB", 4) == 0
+        && header.version == TABLEBASE_VERSION;
+    if (isValid) {
+        packed.resize((header.entryCount + 3) / 4);
+        isValid = fread(packed.data(), 1, packed.size(), file) == packed.size();
+    }
+    fclose(file);
+    return isValid;
+}
+
+// Illegal entries take the value before them, or after them at the start of a block
+static std::vector<uint8_t> blockValues(const std::vector<uint8_t>& packed, uint64_t first, uint64_t count) {
+    std::vector<uint8_t> values(count);
+    uint8_t previous = WDL_ILLEGAL;
+    for (uint64_t k = 0; k < count; k++) {
+        values[k] = packedValue(packed.data(), first + k);
+        if (values[k] == WDL_ILLEGAL) {
+            values[k] = previous;
+        }
+        previous = values[k];
+    }
+    for (uint64_t k = count; k-- > 0; ) {
+        if (values[k] == WDL_ILLEGAL) {
+            values[k] = previous;
+        }
+        previous = values[k];
+    }
+    return values;
+}
+
+static void appendWord(std::vector<uint8_t>& bytes, uint32_t word) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        bytes.push_back(static_cast<uint8_t>(word >> shift));
+    }
+}
+
+struct CompressedTable {
+    std::vector<uint8_t> bytes;
+    uint32_t rleBlocks = 0;
+};
+
+static CompressedTable compress(const TablebaseHeader& source, const std::vector<uint8_t>& packed, int blockShift) {
+    uint32_t blockSize = 1u << blockShift;
+    uint32_t blockCount = static_cast<uint32_t>((source.entryCount + blockSize - 1) / blockSize);
+    std::vector<uint32_t> offsets;
+    std::vector<uint8_t> data;
+    CompressedTable table;
+
+    for (uint32_t block = 0; block < blockCount; block++) {
+        uint64_t first = static_cast<uint64_t>(block) << blockShift;
+        uint64_t count = std::min<uint64_t>(blockSize, source.entryCount - first);
+        std::vector<uint8_t> values = blockValues(packed, first, count);
+
+        std::vector<uint8_t> runs;
+        for (uint64_t k = 0; k < count; ) {
+            uint8_t length = 1;
+            while (k + length < count && length < BLOCK_RUN_LIMIT && values[k + length] == values[k]) {
+                length++;
+            }
+            runs.push_back(static_cast<uint8_t>((values[k] << 6) | (length - 1)));
+            k += length;
+        }
+
+        std::vector<uint8_t> raw((count + 3) / 4, 0);
+        for (uint64_t k = 0; k < count; k++) {
+            raw[k / 4] |= values[k] << (2 * (k % 4));
+        }
+
+        bool isRle = runs.size() < raw.size();
+        offsets.push_back(static_cast<uint32_t>(data.size()) | (isRle ? BLOCK_RLE_FLAG : 0));
+        const std::vector<uint8_t>& encoded = isRle ? runs : raw;
+        data.insert(data.end(), encoded.begin(), encoded.end());
+        table.rleBlocks += isRle;
+    }
+    offsets.push_back(static_cast<uint32_t>(data.size()));
+
+    BlockTablebaseHeader header = { { 'T', 'T', 'T', 'C' }, BLOCK_TABLEBASE_VERSION,
+        source.boardSize, source.winLength, static_cast<uint8_t>(blockShift),
+        static_cast<uint32_t>(source.entryCount), blockCount };
+    table.bytes.resize(sizeof(header));
+    memcpy(table.bytes.data(), &header, sizeof(header));
+    for (uint32_t offset : offsets) {
+        appendWord(table.bytes, offset);
+    }
+    table.bytes.insert(table.bytes.end(), data.begin(), data.end());
+    return table;
+}
+
+static bool writeFile(const std::string& path, const std::vector<uint8_t>& bytes) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool isWritten = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return fclose(file) == 0 && isWritten;
+}
+
+// The sketch includes the header and compiles the array once from the .cpp next to it;
+// the array stays in flash
+static bool writeProgmemHeader(const std::string& path, const std::vector<uint8_t>& bytes, const TablebaseHeader& source) {
+    std::string name = path.substr(path.find_last_of("/\\") + 1);
+    FILE* header = fopen(path.c_str(), "w");
+    if (header == nullptr) {
+        return false;
+    }
+    fprintf(header, "#ifndef TABLEBASE_%dX%d_H\n#define TABLEBASE_%dX%d_H\n\n", source.boardSize, source.boardSize, source.boardSize, source.boardSize);
+    fprintf(header, "// Generated by tablebase_compress: %dx%d, %d in a row, BlockTablebase.h format\n\n", source.boardSize, source.boardSize, source.winLength);
+    fprintf(header, "#include \"BlockTablebase.h\"\n\n");
+    fprintf(header, "#define TABLEBASE_%dX%d tablebase%dx%d\n\n", source.boardSize, source.boardSize, source.boardSize, source.boardSize);
+    fprintf(header, "extern const uint8_t tablebase%dx%d[%zu] PROGMEM;\n\n#endif\n", source.boardSize, source.boardSize, bytes.size());
+    if (fclose(header) != 0) {
+        return false;
+    }
+
+    FILE* file = fopen((path.substr(0, path.rfind('.')) + ".cpp").c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    fprintf(file, "// Generated by tablebase_compress: %dx%d, %d in a row, BlockTablebase.h format\n\n", source.boardSize, source.boardSize, source.winLength);
+    fprintf(file, "#include \"%s\"\n\n", name.c_str());
+    fprintf(file, "const uint8_t tablebase%dx%d[%zu] PROGMEM = {", source.boardSize, source.boardSize, bytes.size());
+    for (size_t k = 0; k < bytes.size(); k++) {
+        fprintf(file, "%s0x%02X%s", (k % 16 == 0) ? "\n    " : "", bytes[k], (k + 1 < bytes.size()) ? "," : "");
+        if (k % 16 != 15 && k + 1 < bytes.size()) {
+            fputc(' ', file);
+        }
+    }
+    fprintf(file, "\n};\n");
+    return fclose(file) == 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <tablebase file> [output file] [block size log2, 6..16] [PROGMEM header, writes a .cpp next to it]" << std::endl;
+        return 1;
+    }
+    std::string input = argv[1];
+    std::string output = (argc > 2) ? argv[2] : input.substr(0, input.rfind('.')) + ".tbc";
+    int blockShift = (argc > 3) ? atoi(argv[3]) : 10;
+    std::string progmemHeader = (argc > 4) ? argv[4] : "";
+    if (blockShift < 6 || blockShift > 16) {
+        std::cout << "Block size log2 must be 6..16" << std::endl;
+        return 1;
+    }
+
+    TablebaseHeader source;
+    std::vector<uint8_t> packed;
+    if (!readTablebase(input, source, packed)) {
+        std::cerr << "Invalid tablebase file: " << input << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    CompressedTable table = compress(source, packed, blockShift);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!writeFile(output, table.bytes) || (!progmemHeader.empty() && !writeProgmemHeader(progmemHeader, table.bytes, source))) {
+        std::cerr << "Failed to write " << output << std::endl;
+        return 1;
+    }
+
+    // Every legal entry must come back unchanged
+    uint64_t mismatches = 0;
+    uint64_t probes = 0;
+    auto probeStart = std::chrono::steady_clock::now();
+    for (uint64_t index = 0; index < source.entryCount; index++) {
+        uint8_t expected = packedValue(packed.data(), index);
+        if (expected != WDL_ILLEGAL) {
+            mismatches += probeBlockTablebase(table.bytes.data(), static_cast<uint32_t>(index)) != expected;
+            probes++;
+        }
+    }
+    double probeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - probeStart).count();
+
+    uint32_t blockCount = static_cast<uint32_t>((source.entryCount + (1u << blockShift) - 1) >> blockShift);
+    std::cout << int(source.boardSize) << "x" << int(source.boardSize) << ": " << packed.size() << " bytes packed -> "
+              << table.bytes.size() << " bytes (" << 100.0 * table.bytes.size() / packed.size() << "%), "
+              << blockCount << " blocks of " << (1u << blockShift) << " entries, " << table.rleBlocks << " RLE, "
+              << seconds << " s" << std::endl;
+    std::cout << probes << " legal entries checked, " << mismatches << " mismatches, "
+              << 1e9 * probeSeconds / probes << " ns per probe, written to " << output << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
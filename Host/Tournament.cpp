@@ -0,0 +1,420 @@
+// Self-play match between two 3x3 engines on all cores. Every opening (a few random
+// plies) is played twice with the colours swapped. The match stops as soon as the
+// sequential probability ratio test decides between "A is not stronger than B by elo0"
+// and "A is stronger by elo1", or, with --test speed, as soon as the difference in
+// thinking time per move is significant. Reports W/D/L from A's side, the Elo
+// difference with a 95% interval and games per second. --test fixed just plays --games
+// games, to measure engines far apart in strength such as the SetLevel levels.
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Engines.h"
+#include "GameCore.h"
+#include "Tablebase3x3.h"
+
+// Returns the cell (0..8) to play
+typedef int (*EngineMove)(uint32_t cells, char player, std::mt19937& random);
+
+static int minimaxMove(uint32_t cells, char player, std::mt19937&) {
+    int move[2];
+    bestMove(cells, player, move);
+    return move[0] * BOARD_SIZE + move[1];
+}
+
+static int tablebaseMove(uint32_t cells, char player, std::mt19937&) {
+    int move[2];
+    tablebaseBestMove(TABLEBASE_3X3, cells, player, move);
+    return move[0] * BOARD_SIZE + move[1];
+}
+
+static int randomMove(uint32_t cells, char, std::mt19937& random) {
+    int free[CELL_COUNT];
+    int count = 0;
+    for (int k = 0; k < CELL_COUNT; k++) {
+        if (cellAt(cells, k) == CELL_EMPTY) {
+            free[count++] = k;
+        }
+    }
+    return free[random() % count];
+}
+
+// Takes an immediate win, blocks an immediate loss, otherwise plays at random
+static int greedyMove(uint32_t cells, char player, std::mt19937& random) {
+    for (char side : { player, opponent(player) }) {
+        for (int k = 0; k < CELL_COUNT; k++) {
+            if (cellAt(cells, k) == CELL_EMPTY && checkWin(withCell(cells, k, pieceOf(side)), side)) {
+                return k;
+            }
+        }
+    }
+    return randomMove(cells, player, random);
+}
+
+// SetLevel 1..4 of the sketch; level 5 is minimax
+template <int LEVEL>
+static int levelEngineMove(uint32_t cells, char player, std::mt19937& random) {
+    uint16_t noiseState = static_cast<uint16_t>(random() | 1);
+    int move[2];
+    levelMove(cells, player, LEVEL, noiseState, move);
+    return move[0] * BOARD_SIZE + move[1];
+}
+
+// An engine of the SetEngine registry, its random state seeded per move
+static int registeredEngineMove(const char* name, uint32_t cells, char player, std::mt19937& random) {
+    uint16_t engineState = static_cast<uint16_t>(random() | 1);
+    int move[2];
+    chooseEngineMove(findEngine(name), cells, player, engineState, move);
+    return move[0] * BOARD_SIZE + move[1];
+}
+
+static int alphaBetaMove(uint32_t cells, char player, std::mt19937& random) {
+    return registeredEngineMove("alphabeta", cells, player, random);
+}
+
+static int mctsMove(uint32_t cells, char player, std::mt19937& random) {
+    return registeredEngineMove("mcts", cells, player, random);
+}
+
+struct Engine {
+    const char* name;
+    EngineMove move;
+};
+
+static const Engine ENGINES[] = {
+    { "minimax", minimaxMove },
+    { "tablebase", tablebaseMove },
+    { "alphabeta", alphaBetaMove },
+    { "mcts", mctsMove },
+    { "greedy", greedyMove },
+    { "random", randomMove },
+    { "level1", levelEngineMove<1> },
+    { "level2", levelEngineMove<2> },
+    { "level3", levelEngineMove<3> },
+    { "level4", levelEngineMove<4> },
+};
+
+static const Engine* findMatchEngine(const char* name) {
+    for (const Engine& engine : ENGINES) {
+        if (strcmp(engine.name, name) == 0) {
+            return &engine;
+        }
+    }
+    return nullptr;
+}
+
+struct MatchSettings {
+    const Engine* engines[2] = { nullptr, nullptr };
+    uint64_t maxGames = 1000000;
+    unsigned threads = 0;
+    int openingPlies = 2;
+    double elo0 = 0;
+    double elo1 = 10;
+    double alpha = 0.05;
+    double beta = 0.05;
+    bool isSpeedTest = false;
+    bool isFixedLength = false;
+    uint64_t seed = 1;
+};
+
+// Totals from engine A's side
+struct MatchTotals {
+    uint64_t wins = 0;
+    uint64_t draws = 0;
+    uint64_t losses = 0;
+    double thinkDifferenceSum = 0; // Per game, A's minus B's mean nanoseconds per move
+    double thinkDifferenceSquares = 0;
+    double thinkNanoseconds[2] = { 0, 0 };
+    uint64_t moves[2] = { 0, 0 };
+
+    uint64_t games() const { return wins + draws + losses; }
+};
+
+static double scoreToElo(double score) {
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+static double eloToScore(double elo) {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+// Mean score of A and its variance per game
+static void scoreStatistics(const MatchTotals& totals, double& mean, double& variance) {
+    double n = static_cast<double>(totals.games());
+    mean = (totals.wins + 0.5 * totals.draws) / n;
+    variance = (totals.wins * (1 - mean) * (1 - mean) + totals.draws * (0.5 - mean) * (0.5 - mean)
+        + totals.losses * mean * mean) / n;
+}
+
+// Generalized SPRT with the normal approximation of the score
+static double logLikelihoodRatio(const MatchTotals& totals, const MatchSettings& settings) {
+    double mean, variance;
+    scoreStatistics(totals, mean, variance);
+    if (variance <= 0) {
+        return 0; // Only draws (or only wins) so far, nothing to tell the hypotheses apart
+    }
+    double score0 = eloToScore(settings.elo0);
+    double score1 = eloToScore(settings.elo1);
+    return totals.games() * (score1 - score0) * (2 * mean - score0 - score1) / (2 * variance);
+}
+
+// Plays one game with A as X when isAFirst; returns 1, 0.5 or 0 for A
+static double playGame(const MatchSettings& settings, bool isAFirst, std::mt19937& random, double thinkNanoseconds[2], int moves[2]) {
+    uint32_t cells = EMPTY_BOARD;
+    for (int ply = 0; ply < settings.openingPlies && !isGameOver(cells); ply++) {
+        cells = withCell(cells, randomMove(cells, sideToMove(cells), random), pieceOf(sideToMove(cells)));
+    }
+    while (!isGameOver(cells)) {
+        char player = sideToMove(cells);
+        int side = ((player == PLAYER_X) == isAFirst) ? 0 : 1;
+        auto start = std::chrono::steady_clock::now();
+        int cell = settings.engines[side]->move(cells, player, random);
+        thinkNanoseconds[side] += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        moves[side]++;
+        cells = withCell(cells, cell, pieceOf(player));
+    }
+    char aPlayer = isAFirst ? PLAYER_X : PLAYER_O;
+    if (checkWin(cells, aPlayer)) {
+        return 1;
+    }
+    return checkWin(cells, opponent(aPlayer)) ? 0 : 0.5;
+}
+
+class Match {
+public:
+    explicit Match(const MatchSettings& settings) : settings(settings) {}
+
+    // Plays game pairs until the test decides or maxGames is reached
+    MatchTotals run() {
+        unsigned threads = settings.threads ? settings.threads : std::max(1u, std::thread::hardware_concurrency());
+        start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([this]() { playPairs(); });
+        }
+
+        auto lastReport = start;
+        while (!isFinished) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            MatchTotals snapshot = totalsSnapshot();
+            if (snapshot.games() >= settings.maxGames || isDecided(snapshot)) {
+                isFinished = true;
+            }
+            if (std::chrono::steady_clock::now() - lastReport >= std::chrono::seconds(1)) {
+                lastReport = std::chrono::steady_clock::now();
+                report(snapshot, false);
+            }
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        MatchTotals final = totalsSnapshot();
+        report(final, true);
+        return final;
+    }
+
+private:
+    static const uint64_t PAIRS_PER_CHUNK = 64;
+
+    MatchSettings settings;
+    std::atomic<uint64_t> nextPair{ 0 };
+    std::atomic<bool> isFinished{ false };
+    std::mutex totalsMutex;
+    MatchTotals totals;
+    std::chrono::steady_clock::time_point start;
+
+    // Each pair has its own seed, so the games do not depend on the thread count
+    void playPairs() {
+        while (!isFinished) {
+            uint64_t first = nextPair.fetch_add(PAIRS_PER_CHUNK);
+            if (2 * first >= settings.maxGames) {
+                return;
+            }
+            MatchTotals chunk;
+            for (uint64_t pair = first; pair < first + PAIRS_PER_CHUNK && 2 * pair < settings.maxGames; pair++) {
+                for (int game = 0; game < 2; game++) {
+                    std::mt19937 random(static_cast<uint32_t>(settings.seed * 0x9E3779B9u + pair));
+                    double thinkNanoseconds[2] = { 0, 0 };
+                    int moves[2] = { 0, 0 };
+                    double score = playGame(settings, game == 0, random, thinkNanoseconds, moves);
+                    chunk.wins += (score == 1);
+                    chunk.draws += (score == 0.5);
+                    chunk.losses += (score == 0);
+                    for (int side = 0; side < 2; side++) {
+                        chunk.thinkNanoseconds[side] += thinkNanoseconds[side];
+                        chunk.moves[side] += moves[side];
+                    }
+                    double difference = thinkNanoseconds[0] / std::max(1, moves[0]) - thinkNanoseconds[1] / std::max(1, moves[1]);
+                    chunk.thinkDifferenceSum += difference;
+                    chunk.thinkDifferenceSquares += difference * difference;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(totalsMutex);
+            totals.wins += chunk.wins;
+            totals.draws += chunk.draws;
+            totals.losses += chunk.losses;
+            totals.thinkDifferenceSum += chunk.thinkDifferenceSum;
+            totals.thinkDifferenceSquares += chunk.thinkDifferenceSquares;
+            for (int side = 0; side < 2; side++) {
+                totals.thinkNanoseconds[side] += chunk.thinkNanoseconds[side];
+                totals.moves[side] += chunk.moves[side];
+            }
+        }
+    }
+
+    MatchTotals totalsSnapshot() {
+        std::lock_guard<std::mutex> lock(totalsMutex);
+        return totals;
+    }
+
+    bool isDecided(const MatchTotals& snapshot) const {
+        if (snapshot.games() == 0 || settings.isFixedLength) {
+            return false;
+        }
+        if (settings.isSpeedTest) {
+            return snapshot.games() >= 1000 && std::fabs(speedZ(snapshot)) > 3.0;
+        }
+        double llr = logLikelihoodRatio(snapshot, settings);
+        return llr <= lowerBound() || llr >= upperBound();
+    }
+
+    double lowerBound() const { return std::log(settings.beta / (1 - settings.alpha)); }
+    double upperBound() const { return std::log((1 - settings.beta) / settings.alpha); }
+
+    // Mean per-game difference in time per move over its standard error
+    static double speedZ(const MatchTotals& snapshot) {
+        double n = static_cast<double>(snapshot.games());
+        double mean = snapshot.thinkDifferenceSum / n;
+        double variance = snapshot.thinkDifferenceSquares / n - mean * mean;
+        return (variance > 0) ? mean / std::sqrt(variance / n) : 0;
+    }
+
+    void report(const MatchTotals& snapshot, bool isFinal) const {
+        uint64_t games = snapshot.games();
+        if (games == 0) {
+            return;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double mean, variance;
+        scoreStatistics(snapshot, mean, variance);
+        double margin = 1.96 * std::sqrt(variance / games);
+
+        std::cout << std::fixed << std::setprecision(1) << "games " << games
+                  << "  W/D/L " << snapshot.wins << "/" << snapshot.draws << "/" << snapshot.losses
+                  << "  Elo " << formatElo(scoreToElo(mean))
+                  << " [" << formatElo(scoreToElo(std::max(0.0, mean - margin))) << ", " << formatElo(scoreToElo(std::min(1.0, mean + margin))) << "]"
+                  << "  LLR " << std::setprecision(2) << logLikelihoodRatio(snapshot, settings)
+                  << " (" << lowerBound() << ", " << upperBound() << ")"
+                  << std::setprecision(0) << "  " << games / seconds << " games/s" << std::endl;
+        if (!isFinal) {
+            return;
+        }
+
+        for (int side = 0; side < 2; side++) {
+            std::cout << settings.engines[side]->name << ": " << std::setprecision(0)
+                      << snapshot.thinkNanoseconds[side] / std::max<uint64_t>(1, snapshot.moves[side]) << " ns per move" << std::endl;
+        }
+        double llr = logLikelihoodRatio(snapshot, settings);
+        if (settings.isFixedLength) {
+            std::cout << games << " games played" << std::endl;
+        } else if (settings.isSpeedTest) {
+            std::cout << (std::fabs(speedZ(snapshot)) > 3.0 ? "speed difference is significant" : "no significant speed difference")
+                      << " (z = " << std::setprecision(1) << speedZ(snapshot) << ")" << std::endl;
+        } else if (llr >= upperBound()) {
+            std::cout << "H1 accepted: " << settings.engines[0]->name << " is stronger by at least " << settings.elo1 << " Elo" << std::endl;
+        } else if (llr <= lowerBound()) {
+            std::cout << "H0 accepted: " << settings.engines[0]->name << " is not stronger by " << settings.elo1 << " Elo" << std::endl;
+        } else {
+            std::cout << "no decision after " << games << " games" << std::endl;
+        }
+    }
+
+    static std::string formatElo(double elo) {
+        if (std::isinf(elo) || std::isnan(elo)) {
+            return elo < 0 ? "-inf" : "+inf";
+        }
+        char text[32];
+        snprintf(text, sizeof(text), "%+.1f", elo);
+        return text;
+    }
+};
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " <engine A> <engine B> [--games <max>] [--threads <count>] [--opening-plies <count>]"
+              << " [--elo0 <elo>] [--elo1 <elo>] [--alpha <p>] [--beta <p>] [--test elo|speed|fixed] [--seed <number>]" << std::endl;
+    std::cout << "Engines:";
+    for (const Engine& engine : ENGINES) {
+        std::cout << " " << engine.name;
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    MatchSettings settings;
+    if (argc < 3 || !(settings.engines[0] = findMatchEngine(argv[1])) || !(settings.engines[1] = findMatchEngine(argv[2]))) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--games") == 0 && i + 1 < argc) {
+            settings.maxGames = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            settings.threads = static_cast<unsigned>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--opening-plies") == 0 && i + 1 < argc) {
+            settings.openingPlies = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--elo0") == 0 && i + 1 < argc) {
+            settings.elo0 = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--elo1") == 0 && i + 1 < argc) {
+            settings.elo1 = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--alpha") == 0 && i + 1 < argc) {
+            settings.alpha = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--beta") == 0 && i + 1 < argc) {
+            settings.beta = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            settings.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--test") == 0 && i + 1 < argc && strcmp(argv[i + 1], "elo") == 0) {
+            settings.isSpeedTest = false;
+            settings.isFixedLength = false;
+            i++;
+        } else if (strcmp(argv[i], "--test") == 0 && i + 1 < argc && strcmp(argv[i + 1], "speed") == 0) {
+            settings.isSpeedTest = true;
+            settings.isFixedLength = false;
+            i++;
+        } else if (strcmp(argv[i], "--test") == 0 && i + 1 < argc && strcmp(argv[i + 1], "fixed") == 0) {
+            settings.isFixedLength = true;
+            settings.isSpeedTest = false;
+            i++;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (settings.maxGames == 0 || settings.elo1 <= settings.elo0 || settings.openingPlies < 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout << settings.engines[0]->name << " vs " << settings.engines[1]->name << ", "
+              << settings.openingPlies << " random opening plies, ";
+    if (settings.isFixedLength) {
+        std::cout << settings.maxGames << " games" << std::endl;
+    } else if (settings.isSpeedTest) {
+        std::cout << "speed test" << std::endl;
+    } else {
+        std::cout << "SPRT elo0 " << settings.elo0 << " elo1 " << settings.elo1 << std::endl;
+    }
+    Match match(settings);
+    match.run();
+    return 0;
+}
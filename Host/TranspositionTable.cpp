@@ -0,0 +1,114 @@
+#include "TranspositionTable.h"
+
+#include <iostream>
+
+#include <sys/mman.h>
+
+static_assert(sizeof(std::atomic<uint64_t>) == 8, "slots must be plain 64-bit words");
+
+TranspositionTable::TranspositionTable(size_t megabytes, bool useHugePages) {
+    size_t bytes = (megabytes > 0 ? megabytes : 1) << 20;
+    bucketCount = 1;
+    while (bucketCount * 2 * sizeof(Bucket) <= bytes) {
+        bucketCount *= 2;
+    }
+    mappedBytes = bucketCount * sizeof(Bucket);
+
+    void* memory = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (useHugePages) {
+        memory = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        isHugeTlb = (memory != MAP_FAILED);
+    }
+#endif
+    if (memory == MAP_FAILED) {
+        memory = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#ifdef MADV_HUGEPAGE
+        if (memory != MAP_FAILED && useHugePages) {
+            madvise(memory, mappedBytes, MADV_HUGEPAGE);
+        }
+#endif
+    }
+    if (memory == MAP_FAILED) {
+        std::cerr << "Failed to allocate the transposition table" << std::endl;
+        bucketCount = 0;
+        mappedBytes = 0;
+        return;
+    }
+    // Anonymous pages are zero-filled: every slot starts out empty
+    buckets = static_cast<Bucket*>(memory);
+}
+
+TranspositionTable::~TranspositionTable() {
+    if (buckets) {
+        munmap(buckets, mappedBytes);
+    }
+}
+
+// data: score (16 bits) | depth (8) | move + 1 (8) | bound (2). A stored entry always
+// has a bound, so data == 0 marks an empty slot
+uint64_t TranspositionTable::pack(const Entry& entry) {
+    return static_cast<uint64_t>(static_cast<uint16_t>(entry.score))
+        | static_cast<uint64_t>(static_cast<uint8_t>(entry.depth)) << 16
+        | static_cast<uint64_t>(static_cast<uint8_t>(entry.move + 1)) << 24
+        | static_cast<uint64_t>(entry.bound) << 32;
+}
+
+TranspositionTable::Entry TranspositionTable::unpack(uint64_t data) {
+    Entry entry;
+    entry.score = static_cast<int16_t>(data & 0xFFFF);
+    entry.depth = static_cast<uint8_t>(data >> 16);
+    entry.move = static_cast<int>(static_cast<uint8_t>(data >> 24)) - 1;
+    entry.bound = static_cast<Bound>((data >> 32) & 3);
+    return entry;
+}
+
+bool TranspositionTable::probe(uint64_t key, Entry& entry) const {
+    if (bucketCount == 0) {
+        return false;
+    }
+    const Bucket& bucket = buckets[key & (bucketCount - 1)];
+    for (const Slot& slot : bucket.slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if (data != 0 && (slot.check.load(std::memory_order_relaxed) ^ data) == key) {
+            entry = unpack(data);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Replaces the slot holding the same key, else an empty one, else the shallowest
+void TranspositionTable::store(uint64_t key, const Entry& entry) {
+    if (bucketCount == 0) {
+        return;
+    }
+    Bucket& bucket = buckets[key & (bucketCount - 1)];
+    Slot* target = &bucket.slots[0];
+    int shallowest = 256;
+    for (Slot& slot : bucket.slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if (data == 0 || (slot.check.load(std::memory_order_relaxed) ^ data) == key) {
+            target = &slot;
+            break;
+        }
+        int depth = static_cast<uint8_t>(data >> 16);
+        if (depth < shallowest) {
+            shallowest = depth;
+            target = &slot;
+        }
+    }
+
+    uint64_t data = pack(entry);
+    target->check.store(key ^ data, std::memory_order_relaxed);
+    target->data.store(data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < bucketCount; i++) {
+        for (Slot& slot : buckets[i].slots) {
+            slot.check.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+}
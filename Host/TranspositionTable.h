@@ -0,0 +1,64 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Transposition table shared by all search threads without locks.
+// Every slot is two words, check = key ^ data and data. A reader accepts the slot only if
+// check ^ data gives back its key, so a slot torn by two concurrent writers reads as a miss.
+// Four slots make one bucket, aligned to a cache line so a probe touches one line.
+class TranspositionTable {
+public:
+    enum Bound : uint8_t {
+        BOUND_NONE = 0,
+        BOUND_EXACT,
+        BOUND_LOWER, // Score is at least this (fail high)
+        BOUND_UPPER  // Score is at most this (fail low)
+    };
+
+    struct Entry {
+        int score = 0;
+        int depth = 0;
+        int move = -1;
+        Bound bound = BOUND_NONE;
+    };
+
+    // The table is rounded down to a power of two of buckets. With useHugePages the memory
+    // is requested from the huge page pool first, then as transparent huge pages
+    TranspositionTable(size_t megabytes, bool useHugePages);
+    ~TranspositionTable();
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    bool probe(uint64_t key, Entry& entry) const;
+    void store(uint64_t key, const Entry& entry);
+    void clear();
+
+    size_t sizeBytes() const { return bucketCount * sizeof(Bucket); }
+    bool isOnHugePages() const { return isHugeTlb; }
+
+private:
+    static const int SLOTS_PER_BUCKET = 4;
+
+    struct Slot {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> data;
+    };
+
+    struct alignas(64) Bucket {
+        Slot slots[SLOTS_PER_BUCKET];
+    };
+
+    Bucket* buckets = nullptr;
+    size_t bucketCount = 0;
+    size_t mappedBytes = 0;
+    bool isHugeTlb = false;
+
+    static uint64_t pack(const Entry& entry);
+    static Entry unpack(uint64_t data);
+};
+
+#endif
@@ -0,0 +1,148 @@
+#include "WorkStealingPool.h"
+
+// Index of the pool worker running on this thread, -1 outside the pool
+static thread_local int currentWorker = -1;
+static thread_local const WorkStealingPool* currentPool = nullptr;
+
+WorkStealingPool::WorkStealingPool(unsigned workerCount) {
+    if (workerCount == 0) {
+        workerCount = std::thread::hardware_concurrency();
+    }
+    if (workerCount == 0) {
+        workerCount = 1;
+    }
+
+    for (unsigned i = 0; i < workerCount; i++) {
+        workers.emplace_back(new Worker());
+    }
+    for (unsigned i = 0; i < workerCount; i++) {
+        workers[i]->thread = std::thread(&WorkStealingPool::run, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        isStopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto& worker : workers) {
+        worker->thread.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task) {
+    // Workers keep their own subtasks local, everything else is spread round-robin
+    unsigned index = (currentPool == this && currentWorker >= 0)
+        ? static_cast<unsigned>(currentWorker)
+        : nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+
+    // Counted before it is published: a thief may finish it before push_back() returns
+    pending.fetch_add(1);
+    size_t depth;
+    {
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        workers[index]->tasks.push_back(std::move(task));
+        depth = workers[index]->tasks.size();
+    }
+
+    size_t seen = maxQueueDepth.load(std::memory_order_relaxed);
+    while (depth > seen && !maxQueueDepth.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {
+    }
+
+    // Sleeping workers wake on a new submitted count, so it only changes once the task is there
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        submitted.fetch_add(1);
+    }
+    wakeUp.notify_one();
+}
+
+void WorkStealingPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    idle.wait(lock, [this] { return pending.load() == 0; });
+}
+
+WorkStealingPool::Metrics WorkStealingPool::metrics() const {
+    Metrics result;
+    for (const auto& worker : workers) {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        result.queueDepth += worker->tasks.size();
+    }
+    result.maxQueueDepth = maxQueueDepth.load(std::memory_order_relaxed);
+    result.submitted = submitted.load(std::memory_order_relaxed);
+    result.executed = executed.load(std::memory_order_relaxed);
+    result.steals = steals.load(std::memory_order_relaxed);
+    return result;
+}
+
+void WorkStealingPool::run(unsigned index) {
+    currentWorker = static_cast<int>(index);
+    currentPool = this;
+
+    while (true) {
+        // Any submit after this point changes the counter and cancels the sleep below
+        uint64_t seenSubmits = submitted.load();
+
+        Task task;
+        if (popOwn(index, task) || steal(index, task)) {
+            finish(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [&] { return isStopping || submitted.load() != seenSubmits; });
+        if (isStopping) {
+            return;
+        }
+    }
+}
+
+bool WorkStealingPool::runPendingTask() {
+    Task task;
+    bool isWorker = (currentPool == this && currentWorker >= 0);
+    unsigned index = isWorker ? static_cast<unsigned>(currentWorker)
+        : nextWorker.load(std::memory_order_relaxed) % workers.size();
+    // An outside thread has no deque of its own; steal() skips the thief's, so check it here
+    if (popOwn(index, task) || steal(index, task)) {
+        finish(task);
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::finish(Task& task) {
+    task();
+    executed.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    if (pending.fetch_sub(1) == 1) {
+        idle.notify_all();
+    }
+}
+
+bool WorkStealingPool::popOwn(unsigned index, Task& task) {
+    Worker& worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(unsigned thief, Task& task) {
+    for (size_t offset = 1; offset < workers.size(); offset++) {
+        Worker& victim = *workers[(thief + offset) % workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) {
+            continue;
+        }
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,72 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed pool with one deque per worker. A worker pops its own newest task first
+// and, when its deque is empty, steals the oldest task of another worker.
+// Tasks submitted from outside the pool are spread round-robin over the deques.
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    struct Metrics {
+        size_t queueDepth = 0;    // Tasks waiting in all deques
+        size_t maxQueueDepth = 0; // Deepest single deque seen so far
+        uint64_t submitted = 0;
+        uint64_t executed = 0;
+        uint64_t steals = 0;
+    };
+
+    // 0 workers means one per core
+    explicit WorkStealingPool(unsigned workerCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(Task task);
+    void waitIdle();
+
+    // Runs one queued task on the calling thread, false if there was none. Lets a task
+    // that waits for its own subtasks help with them instead of blocking a worker
+    bool runPendingTask();
+
+    unsigned workerCount() const { return static_cast<unsigned>(workers.size()); }
+    Metrics metrics() const;
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<unsigned> nextWorker{ 0 };
+    std::atomic<size_t> pending{ 0 };   // Submitted but not finished
+    std::atomic<size_t> maxQueueDepth{ 0 };
+    std::atomic<uint64_t> submitted{ 0 };
+    std::atomic<uint64_t> executed{ 0 };
+    std::atomic<uint64_t> steals{ 0 };
+    std::atomic<bool> isStopping{ false };
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::condition_variable idle;
+
+    void run(unsigned index);
+    bool popOwn(unsigned index, Task& task);
+    bool steal(unsigned thief, Task& task);
+    void finish(Task& task);
+};
+
+#endif
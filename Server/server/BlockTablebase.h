@@ -0,0 +1,112 @@
+#ifndef BLOCK_TABLEBASE_H
+#define BLOCK_TABLEBASE_H
+
+// Compressed win/draw/loss tablebase with random access, written by tablebase_compress
+// from a retrograde_solver table. Entries (2-bit values for the side to move, WDL_* in
+// Host/Tablebase.h) are split into blocks of 2^blockShift; every block is compressed on
+// its own, so a probe decodes one block and touches nothing else.
+//
+// Layout, all numbers little-endian:
+//   16-byte header
+//   (blockCount + 1) x uint32 block offsets from the start of the data, bit 31 set - RLE block
+//   block data
+// A raw block packs four entries per byte. An RLE block is a list of runs, one byte each:
+// bits 6-7 value, bits 0-5 run length - 1.
+// Illegal positions are stored as whatever value extends the current run, so they must not
+// be probed. Plain C++ like GameCore.h: on the sketch the table lives in flash (PROGMEM).
+
+#include <stdint.h>
+
+#include "GameCore.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#define TABLEBASE_READ_BYTE(address) pgm_read_byte(address)
+#else
+#define TABLEBASE_READ_BYTE(address) (*(const uint8_t*)(address))
+#define PROGMEM // Host builds of the generated tables
+#endif
+
+struct BlockTablebaseHeader {
+    char magic[4];       // "TTTC"
+    uint8_t version;
+    uint8_t boardSize;
+    uint8_t winLength;
+    uint8_t blockShift;  // log2 of the entries per block
+    uint32_t entryCount; // 3^(boardSize²)
+    uint32_t blockCount;
+};
+
+const uint8_t BLOCK_TABLEBASE_VERSION = 1;
+const uint32_t BLOCK_RLE_FLAG = 0x80000000;
+const uint8_t BLOCK_RUN_LIMIT = 64;
+
+// Entry values, the same numbers as WDL_* in Host/Tablebase.h
+const uint8_t TABLEBASE_WIN = 1;
+const uint8_t TABLEBASE_LOSS = 2;
+const uint8_t TABLEBASE_DRAW = 3;
+
+inline uint32_t readTablebaseWord(const uint8_t* address) {
+    return (uint32_t)TABLEBASE_READ_BYTE(address)
+        | ((uint32_t)TABLEBASE_READ_BYTE(address + 1) << 8)
+        | ((uint32_t)TABLEBASE_READ_BYTE(address + 2) << 16)
+        | ((uint32_t)TABLEBASE_READ_BYTE(address + 3) << 24);
+}
+
+// Value of one entry; table points at the header
+inline uint8_t probeBlockTablebase(const uint8_t* table, uint32_t index) {
+    uint8_t blockShift = TABLEBASE_READ_BYTE(table + 7);
+    uint32_t blockCount = readTablebaseWord(table + 12);
+    const uint8_t* offsets = table + sizeof(BlockTablebaseHeader);
+    const uint8_t* data = offsets + 4 * (blockCount + 1);
+
+    uint32_t block = index >> blockShift;
+    uint32_t offset = readTablebaseWord(offsets + 4 * block);
+    const uint8_t* start = data + (offset & ~BLOCK_RLE_FLAG);
+    uint32_t position = index & ((1ul << blockShift) - 1);
+    if (!(offset & BLOCK_RLE_FLAG)) {
+        return (TABLEBASE_READ_BYTE(start + (position >> 2)) >> (2 * (position & 3))) & 3;
+    }
+
+    // Walk the runs until the one covering the entry
+    for (const uint8_t* run = start; ; run++) {
+        uint8_t code = TABLEBASE_READ_BYTE(run);
+        uint8_t length = (code & 0x3F) + 1;
+        if (position < length) {
+            return code >> 6;
+        }
+        position -= length;
+    }
+}
+
+// Perfect move from the 3x3 table: an immediate win, else a move into a position lost
+// for the opponent, else one that keeps the draw. Without distances in the table the
+// first such cell is taken; the game still ends with the same result as minimax.
+// move is {row, col} as in bestMove(), {-1, -1} when the board is full
+inline void tablebaseBestMove(const uint8_t* table, uint32_t cells, char aiPlayer, int move[2], SearchCounters* counters = 0) {
+    uint16_t index = positionIndex(cells);
+    uint16_t power = 1;
+    int bestCell = -1;
+    uint8_t bestRank = 0; // 3 - immediate win, 2 - win, 1 - draw
+    for (int k = 0; k < CELL_COUNT; k++, power *= 3) {
+        if (cellAt(cells, k) != CELL_EMPTY) {
+            continue;
+        }
+        uint32_t child = withCell(cells, k, pieceOf(aiPlayer));
+        countNode(counters, 1);
+        uint8_t rank = checkWin(child, aiPlayer) ? 3 : 0;
+        if (rank == 0) {
+            countTableHit(counters);
+            uint8_t value = probeBlockTablebase(table, index + power * pieceOf(aiPlayer));
+            rank = (value == TABLEBASE_LOSS) ? 2 : (value == TABLEBASE_DRAW) ? 1 : 0; // Value for the opponent
+        }
+        if (bestCell < 0 || rank > bestRank) {
+            bestCell = k;
+            bestRank = rank;
+        }
+    }
+    move[0] = (bestCell < 0) ? -1 : bestCell / BOARD_SIZE;
+    move[1] = (bestCell < 0) ? -1 : bestCell % BOARD_SIZE;
+}
+
+#endif
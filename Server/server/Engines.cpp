@@ -0,0 +1,274 @@
+#include "Engines.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "Tablebase3x3.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+// Flash strings are ordinary strings on the host, as in HostPrint.h
+#define PSTR(string_literal) (string_literal)
+#define strcmp_P strcmp
+#endif
+
+// Host servers run engines on several threads and shards. The search state belongs to the
+// session; the statistics are relaxed atomics, so no move waits for another one. A reader
+// may see a move counted before its nodes
+#ifdef ARDUINO
+struct EngineCounters {
+    EngineStats totals;
+
+    void record(uint32_t nodes) {
+        totals.moves++;
+        totals.nodes += nodes;
+    }
+
+    EngineStats read() const {
+        return totals;
+    }
+};
+#else
+#include <atomic>
+struct EngineCounters {
+    std::atomic<uint16_t> moves{ 0 };
+    std::atomic<uint32_t> nodes{ 0 };
+
+    void record(uint32_t moveNodes) {
+        moves.fetch_add(1, std::memory_order_relaxed);
+        nodes.fetch_add(moveNodes, std::memory_order_relaxed);
+    }
+
+    EngineStats read() const {
+        EngineStats totals = { moves.load(std::memory_order_relaxed), nodes.load(std::memory_order_relaxed) };
+        return totals;
+    }
+};
+#endif
+
+// Full minimax, the original AI
+class MinimaxEngine {
+public:
+    static void init() {}
+    static void reset(uint16_t&) {}
+
+    static void choose(uint32_t cells, char player, uint16_t&, int move[2], SearchCounters& counters) {
+        bestMove(cells, player, move, &counters);
+        stats().record(counters.nodes);
+    }
+
+    static EngineCounters& stats() {
+        static EngineCounters counters;
+        return counters;
+    }
+};
+
+// Same moves as minimax; the best score so far is the lower bound for the next root move
+class AlphaBetaEngine {
+public:
+    static void init() {}
+    static void reset(uint16_t&) {}
+
+    static void choose(uint32_t cells, char player, uint16_t&, int move[2], SearchCounters& counters) {
+        int bestScore = SCORE_LOWER_BOUND;
+        move[0] = -1;
+        move[1] = -1;
+        for (int k = 0; k < CELL_COUNT; k++) {
+            if (cellAt(cells, k) == CELL_EMPTY) {
+                int score = alphaBeta(withCell(cells, k, pieceOf(player)), opponent(player), player, 0,
+                                      bestScore, SCORE_UPPER_BOUND, &counters);
+                if (score > bestScore) {
+                    bestScore = score;
+                    move[0] = k / BOARD_SIZE;
+                    move[1] = k % BOARD_SIZE;
+                }
+            }
+        }
+        stats().record(counters.nodes);
+    }
+
+    static EngineCounters& stats() {
+        static EngineCounters counters;
+        return counters;
+    }
+};
+
+// Perfect play from the 3x3 table in flash, one probe per empty cell
+class TableEngine {
+public:
+    static void init() {}
+    static void reset(uint16_t&) {}
+
+    static void choose(uint32_t cells, char player, uint16_t&, int move[2], SearchCounters& counters) {
+        tablebaseBestMove(TABLEBASE_3X3, cells, player, move, &counters);
+        stats().record(counters.nodes);
+    }
+
+    static EngineCounters& stats() {
+        static EngineCounters counters;
+        return counters;
+    }
+};
+
+// Monte Carlo tree search with the tree cut to the root: the moves are UCB1 bandit arms,
+// each iteration plays one random game. The full tree does not fit into the Uno's SRAM
+const uint16_t MCTS_PLAYOUTS = 256;
+const float MCTS_EXPLORATION = 1.4f;
+
+class MctsEngine {
+public:
+    static void init() {}
+
+    // Every game replays the same random sequence
+    static void reset(uint16_t& state) {
+        state = 0xACE1;
+    }
+
+    static void choose(uint32_t cells, char player, uint16_t& state, int move[2], SearchCounters& counters) {
+        uint16_t visits[CELL_COUNT] = { 0 };
+        uint16_t points[CELL_COUNT] = { 0 }; // 2 per win, 1 per draw
+        for (uint16_t playout = 0; playout < MCTS_PLAYOUTS; playout++) {
+            int arm = -1;
+            float bestValue = -1;
+            for (int k = 0; k < CELL_COUNT; k++) {
+                if (cellAt(cells, k) != CELL_EMPTY) {
+                    continue;
+                }
+                if (visits[k] == 0) {
+                    arm = k;
+                    break;
+                }
+                float value = points[k] / (2.0f * visits[k]) + MCTS_EXPLORATION * sqrtf(logf(playout) / visits[k]);
+                if (value > bestValue) {
+                    bestValue = value;
+                    arm = k;
+                }
+            }
+            if (arm < 0) {
+                break; // Board is full
+            }
+            visits[arm]++;
+            points[arm] += playRandomGame(withCell(cells, arm, pieceOf(player)), player, state, counters);
+        }
+
+        int best = -1;
+        for (int k = 0; k < CELL_COUNT; k++) {
+            if (cellAt(cells, k) == CELL_EMPTY && (best < 0 || visits[k] > visits[best])) {
+                best = k;
+            }
+        }
+        move[0] = (best < 0) ? -1 : best / BOARD_SIZE;
+        move[1] = (best < 0) ? -1 : best % BOARD_SIZE;
+        stats().record(counters.nodes);
+    }
+
+    static EngineCounters& stats() {
+        static EngineCounters counters;
+        return counters;
+    }
+
+private:
+    // Random moves until the game ends: 2 if player wins, 1 for a draw, 0 for a loss
+    static uint8_t playRandomGame(uint32_t cells, char player, uint16_t& state, SearchCounters& counters) {
+        char mover = opponent(player);
+        for (int depth = 1; ; depth++) {
+            countNode(&counters, depth);
+            if (checkWin(cells, player)) {
+                return 2;
+            } else if (checkWin(cells, opponent(player))) {
+                return 0;
+            } else if (isBoardFull(cells)) {
+                return 1;
+            }
+            int empty = CELL_COUNT - countPieces(cells, CELL_X) - countPieces(cells, CELL_O);
+            int pick = nextNoise(state) % empty;
+            for (int k = 0; k < CELL_COUNT; k++) {
+                if (cellAt(cells, k) == CELL_EMPTY && pick-- == 0) {
+                    cells = withCell(cells, k, pieceOf(mover));
+                    break;
+                }
+            }
+            mover = opponent(mover);
+        }
+    }
+};
+
+// Registered engines in SetEngine order: class, name
+#define ENGINE_LIST(ENGINE) \
+    ENGINE(MinimaxEngine, "minimax") \
+    ENGINE(AlphaBetaEngine, "alphabeta") \
+    ENGINE(TableEngine, "table") \
+    ENGINE(MctsEngine, "mcts")
+
+enum EngineId {
+#define ENGINE_ID(type, name) ID_##type,
+    ENGINE_LIST(ENGINE_ID)
+#undef ENGINE_ID
+    ENGINE_COUNT
+};
+
+// Longest name plus its terminator; a longer one does not compile
+const uint8_t ENGINE_NAME_SIZE = 10;
+
+static const char ENGINE_NAMES[ENGINE_COUNT][ENGINE_NAME_SIZE] PROGMEM = {
+#define ENGINE_NAME(type, name) name,
+    ENGINE_LIST(ENGINE_NAME)
+#undef ENGINE_NAME
+};
+
+void initEngines() {
+#define ENGINE_INIT(type, name) type::init();
+    ENGINE_LIST(ENGINE_INIT)
+#undef ENGINE_INIT
+}
+
+uint8_t engineCount() {
+    return ENGINE_COUNT;
+}
+
+const __FlashStringHelper* engineName(uint8_t engine) {
+    return reinterpret_cast<const __FlashStringHelper*>((engine < ENGINE_COUNT) ? ENGINE_NAMES[engine] : PSTR(""));
+}
+
+uint8_t findEngine(const char* name) {
+    for (uint8_t engine = 0; engine < ENGINE_COUNT; engine++) {
+        if (strcmp_P(name, ENGINE_NAMES[engine]) == 0) {
+            return engine;
+        }
+    }
+    return NO_ENGINE;
+}
+
+void resetEngine(uint8_t engine, uint16_t& state) {
+    switch (engine) {
+#define ENGINE_RESET(type, name) case ID_##type: type::reset(state); break;
+    ENGINE_LIST(ENGINE_RESET)
+#undef ENGINE_RESET
+    }
+}
+
+void chooseEngineMove(uint8_t engine, uint32_t cells, char player, uint16_t& state, int move[2], SearchCounters* counters) {
+    SearchCounters moveCounters = SearchCounters();
+    switch (engine) {
+#define ENGINE_CHOOSE(type, name) case ID_##type: type::choose(cells, player, state, move, moveCounters); break;
+    ENGINE_LIST(ENGINE_CHOOSE)
+#undef ENGINE_CHOOSE
+    default:
+        move[0] = -1;
+        move[1] = -1;
+    }
+    if (counters) {
+        *counters = moveCounters;
+    }
+}
+
+EngineStats engineStats(uint8_t engine) {
+    switch (engine) {
+#define ENGINE_STATS(type, name) case ID_##type: return type::stats().read();
+    ENGINE_LIST(ENGINE_STATS)
+#undef ENGINE_STATS
+    }
+    EngineStats noStats = { 0, 0 };
+    return noStats;
+}
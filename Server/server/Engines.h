@@ -0,0 +1,38 @@
+#ifndef ENGINES_H
+#define ENGINES_H
+
+// AI engines that can be picked per side with "SetEngine X|O <name>". Each engine is a
+// class with static init(), reset(), choose() and stats(); the list in Engines.cpp is
+// expanded into switch statements at compile time, so a call through these functions
+// is a direct call with no vtables, which matters on the AVR. Search state that lasts
+// a game (the MCTS random sequence) lives in the session and is passed in as state.
+
+#include <stdint.h>
+
+#include "GameCore.h"
+
+class __FlashStringHelper; // Arduino's flash string, a plain string on the host (HostPrint.h)
+
+struct EngineStats {
+    uint16_t moves;
+    uint32_t nodes; // Positions searched, probed or played out; 0 without SEARCH_TELEMETRY
+};
+
+const uint8_t NO_ENGINE = 0xFF;
+
+// Once at startup
+void initEngines();
+
+uint8_t engineCount();
+// The name in flash, print it like an F() string
+const __FlashStringHelper* engineName(uint8_t engine);
+// Engine number for a name, NO_ENGINE if there is none
+uint8_t findEngine(const char* name);
+
+// New game of the session that owns state
+void resetEngine(uint8_t engine, uint16_t& state);
+// move is {row, col} as in bestMove(); counters receive the telemetry of the move
+void chooseEngineMove(uint8_t engine, uint32_t cells, char player, uint16_t& state, int move[2], SearchCounters* counters = 0);
+EngineStats engineStats(uint8_t engine);
+
+#endif
@@ -0,0 +1,325 @@
+#ifndef GAME_CORE_H
+#define GAME_CORE_H
+
+// Board representation and AI shared by the Arduino sketch and the host server.
+// Plain C++ without Arduino or STL dependencies, so it builds for AVR and Linux alike.
+
+#include <stdint.h>
+
+const int BOARD_SIZE = 3;
+const int CELL_COUNT = BOARD_SIZE * BOARD_SIZE;
+const char PLAYER_X = 'X';
+const char PLAYER_O = 'O';
+
+// Packed board: 2 bits per cell, cell k (0..8) lives in bits 2k..2k+1
+const uint8_t CELL_EMPTY = 0;
+const uint8_t CELL_X = 1;
+const uint8_t CELL_O = 2;
+const uint32_t EMPTY_BOARD = 0;
+const uint32_t X_CELLS_MASK = 0x15555; // Low bit of every cell
+
+// Rows, columns and diagonals; each mask covers both bits of its three cells
+const uint32_t WIN_LINES[] = {
+    0x0003F, 0x00FC0, 0x3F000,  // Rows
+    0x030C3, 0x0C30C, 0x30C30,  // Columns
+    0x30303, 0x03330            // Diagonals
+};
+
+inline uint8_t cellAt(uint32_t cells, int index) {
+    return (cells >> (2 * index)) & 3;
+}
+
+inline uint32_t withCell(uint32_t cells, int index, uint8_t piece) {
+    return (cells & ~((uint32_t)3 << (2 * index))) | ((uint32_t)piece << (2 * index));
+}
+
+inline uint8_t pieceOf(char player) {
+    return (player == PLAYER_X) ? CELL_X : CELL_O;
+}
+
+// 'X', 'O' or the position digit of an empty cell
+inline char cellChar(uint32_t cells, int index) {
+    uint8_t piece = cellAt(cells, index);
+    if (piece == CELL_X) {
+        return PLAYER_X;
+    } else if (piece == CELL_O) {
+        return PLAYER_O;
+    }
+    return '1' + index;
+}
+
+inline int countPieces(uint32_t cells, uint8_t piece) {
+    int count = 0;
+    for (int k = 0; k < CELL_COUNT; k++) {
+        if (cellAt(cells, k) == piece) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// Dense base-3 index of a board, sum of cell * 3^k: 0..19682, one number per board
+const uint16_t POSITION_COUNT = 19683;
+
+inline uint16_t positionIndex(uint32_t cells) {
+    uint16_t index = 0;
+    for (int k = CELL_COUNT - 1; k >= 0; k--) {
+        index = index * 3 + cellAt(cells, k);
+    }
+    return index;
+}
+
+inline char opponent(char player) {
+    return (player == PLAYER_X) ? PLAYER_O : PLAYER_X;
+}
+
+// X always starts, so X is to move when both sides have the same number of marks
+inline char sideToMove(uint32_t cells) {
+    return (countPieces(cells, CELL_X) == countPieces(cells, CELL_O)) ? PLAYER_X : PLAYER_O;
+}
+
+inline bool isPositionValid(uint32_t cells, int position) {
+    return (position >= 1 && position <= CELL_COUNT && cellAt(cells, position - 1) == CELL_EMPTY);
+}
+
+inline bool checkWin(uint32_t cells, char player) {
+    uint32_t pieces = (player == PLAYER_X) ? X_CELLS_MASK : X_CELLS_MASK << 1;
+    for (uint8_t i = 0; i < sizeof(WIN_LINES) / sizeof(WIN_LINES[0]); i++) {
+        if ((cells & WIN_LINES[i]) == (WIN_LINES[i] & pieces)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool isBoardFull(uint32_t cells) {
+    // Every cell holds either 01 or 10, so each pair of bits is non-zero
+    return ((cells | (cells >> 1)) & X_CELLS_MASK) == X_CELLS_MASK;
+}
+
+inline bool isGameOver(uint32_t cells) {
+    return checkWin(cells, PLAYER_X) || checkWin(cells, PLAYER_O) || isBoardFull(cells);
+}
+
+// Search telemetry: work of one search, counted when the search is given a pointer to
+// SearchCounters. Build with SEARCH_TELEMETRY 0 and the counting compiles to nothing
+#ifndef SEARCH_TELEMETRY
+#define SEARCH_TELEMETRY 1
+#endif
+
+struct SearchCounters {
+    uint32_t nodes;
+    uint32_t cutoffs;  // Alpha-beta cutoffs
+    uint32_t ttHits;   // Positions answered by a table instead of a search
+    uint8_t maxDepth;  // Plies below the root
+};
+
+// depth - plies of the node below the root
+inline void countNode(SearchCounters* counters, int depth) {
+#if SEARCH_TELEMETRY
+    if (counters) {
+        counters->nodes++;
+        if (depth > counters->maxDepth) {
+            counters->maxDepth = depth;
+        }
+    }
+#endif
+}
+
+inline void countCutoff(SearchCounters* counters) {
+#if SEARCH_TELEMETRY
+    if (counters) {
+        counters->cutoffs++;
+    }
+#endif
+}
+
+inline void countTableHit(SearchCounters* counters) {
+#if SEARCH_TELEMETRY
+    if (counters) {
+        counters->ttHits++;
+    }
+#endif
+}
+
+inline int minimax(uint32_t cells, char currentPlayer, char aiPlayer, int depth, SearchCounters* counters = 0) {
+    countNode(counters, depth + 1);
+    if (checkWin(cells, aiPlayer)) {
+        return 10 - depth; // AI wins
+    } else if (checkWin(cells, opponent(aiPlayer))) {
+        return depth - 10; // Opponent wins
+    } else if (isBoardFull(cells)) {
+        return 0; // Draw
+    }
+    int bestScore = (currentPlayer == aiPlayer) ? -1000 : 1000;
+
+    for (int k = 0; k < CELL_COUNT; k++) {
+        if (cellAt(cells, k) == CELL_EMPTY) {
+            // The board is passed by value, so there is no move to undo
+            int score = minimax(withCell(cells, k, pieceOf(currentPlayer)), opponent(currentPlayer), aiPlayer, depth + 1, counters);
+            if (currentPlayer == aiPlayer) {
+                if (score > bestScore) {
+                    bestScore = score;
+                }
+            } else {
+                if (score < bestScore)
+                {
+                    bestScore = score;
+                }
+            }
+        }
+    }
+    return bestScore;
+}
+
+// minimax() with alpha-beta pruning: the exact score when it lies strictly between
+// alpha and beta, otherwise a bound on the far side of the window
+inline int alphaBeta(uint32_t cells, char currentPlayer, char aiPlayer, int depth, int alpha, int beta, SearchCounters* counters = 0) {
+    countNode(counters, depth + 1);
+    if (checkWin(cells, aiPlayer)) {
+        return 10 - depth;
+    } else if (checkWin(cells, opponent(aiPlayer))) {
+        return depth - 10;
+    } else if (isBoardFull(cells)) {
+        return 0;
+    }
+
+    for (int k = 0; k < CELL_COUNT && alpha < beta; k++) {
+        if (cellAt(cells, k) == CELL_EMPTY) {
+            int score = alphaBeta(withCell(cells, k, pieceOf(currentPlayer)), opponent(currentPlayer), aiPlayer, depth + 1, alpha, beta, counters);
+            if (currentPlayer == aiPlayer) {
+                if (score > alpha) {
+                    alpha = score;
+                }
+            } else if (score < beta) {
+                beta = score;
+            }
+            if (alpha >= beta) {
+                countCutoff(counters);
+            }
+        }
+    }
+    return (currentPlayer == aiPlayer) ? alpha : beta;
+}
+
+// Window that holds every score of minimax()
+const int SCORE_LOWER_BOUND = -11;
+const int SCORE_UPPER_BOUND = 11;
+
+inline void bestMove(uint32_t cells, char aiPlayer, int move[2], SearchCounters* counters = 0) {
+    int bestScore = -1000;
+    move[0] = -1;
+    move[1] = -1;
+    for (int k = 0; k < CELL_COUNT; k++) {
+        if (cellAt(cells, k) == CELL_EMPTY) {
+            int score = minimax(withCell(cells, k, pieceOf(aiPlayer)), opponent(aiPlayer), aiPlayer, 0, counters);
+            if (score > bestScore) {
+                bestScore = score;
+                move[0] = k / BOARD_SIZE;
+                move[1] = k % BOARD_SIZE;
+            }
+        }
+    }
+}
+
+// Difficulty levels 1..MAX_LEVEL. Below MAX_LEVEL the AI searches only a few plies,
+// scores the leaves with evaluateLines() and adds noise to the scores of its moves;
+// MAX_LEVEL is the perfect play of bestMove()
+const int MAX_LEVEL = 5;
+const uint8_t LEVEL_DEPTHS[MAX_LEVEL] = { 1, 2, 2, 4, CELL_COUNT }; // Plies searched
+const uint8_t LEVEL_NOISE[MAX_LEVEL] = { 12, 8, 2, 1, 0 };          // Noise is -n..n
+const int LEVEL_WIN_SCORE = 100; // Above anything evaluateLines() and the noise can reach
+
+// Static evaluation for aiPlayer: lines still open to one side only,
+// 1 point for one mark in the line, 4 for two; the opponent's count against
+inline int evaluateLines(uint32_t cells, char aiPlayer) {
+    const int LINE_POINTS[] = { 0, 1, 4, 0 };
+    uint32_t aiPieces = (aiPlayer == PLAYER_X) ? X_CELLS_MASK : X_CELLS_MASK << 1;
+    uint32_t opponentPieces = (aiPlayer == PLAYER_X) ? X_CELLS_MASK << 1 : X_CELLS_MASK;
+    int score = 0;
+    for (uint8_t i = 0; i < sizeof(WIN_LINES) / sizeof(WIN_LINES[0]); i++) {
+        uint32_t ai = cells & WIN_LINES[i] & aiPieces;
+        uint32_t other = cells & WIN_LINES[i] & opponentPieces;
+        int aiCount = 0;
+        int otherCount = 0;
+        for (; ai != 0; ai &= ai - 1) {
+            aiCount++;
+        }
+        for (; other != 0; other &= other - 1) {
+            otherCount++;
+        }
+        if (otherCount == 0) {
+            score += LINE_POINTS[aiCount];
+        } else if (aiCount == 0) {
+            score -= LINE_POINTS[otherCount];
+        }
+    }
+    return score;
+}
+
+// alphaBeta() cut off after maxDepth plies; wins score LEVEL_WIN_SCORE - depth
+inline int limitedSearch(uint32_t cells, char currentPlayer, char aiPlayer, int depth, int maxDepth, int alpha, int beta,
+                         SearchCounters* counters = 0) {
+    countNode(counters, depth);
+    if (checkWin(cells, aiPlayer)) {
+        return LEVEL_WIN_SCORE - depth;
+    } else if (checkWin(cells, opponent(aiPlayer))) {
+        return depth - LEVEL_WIN_SCORE;
+    } else if (isBoardFull(cells)) {
+        return 0;
+    } else if (depth >= maxDepth) {
+        return evaluateLines(cells, aiPlayer);
+    }
+
+    for (int k = 0; k < CELL_COUNT && alpha < beta; k++) {
+        if (cellAt(cells, k) == CELL_EMPTY) {
+            int score = limitedSearch(withCell(cells, k, pieceOf(currentPlayer)), opponent(currentPlayer), aiPlayer, depth + 1, maxDepth,
+                                      alpha, beta, counters);
+            if (currentPlayer == aiPlayer) {
+                if (score > alpha) {
+                    alpha = score;
+                }
+            } else if (score < beta) {
+                beta = score;
+            }
+            if (alpha >= beta) {
+                countCutoff(counters);
+            }
+        }
+    }
+    return (currentPlayer == aiPlayer) ? alpha : beta;
+}
+
+// 16-bit xorshift, the state must not be 0
+inline uint16_t nextNoise(uint16_t& state) {
+    state ^= state << 7;
+    state ^= state >> 9;
+    state ^= state << 8;
+    return state;
+}
+
+// Move of a level below MAX_LEVEL, {row, col} as in bestMove(). Every root move is
+// searched with the full window, so the noise is added to exact scores
+inline void levelMove(uint32_t cells, char aiPlayer, int level, uint16_t& noiseState, int move[2], SearchCounters* counters = 0) {
+    int maxDepth = LEVEL_DEPTHS[level - 1];
+    int noise = LEVEL_NOISE[level - 1];
+    int bestScore = -1000;
+    move[0] = -1;
+    move[1] = -1;
+    for (int k = 0; k < CELL_COUNT; k++) {
+        if (cellAt(cells, k) == CELL_EMPTY) {
+            int score = limitedSearch(withCell(cells, k, pieceOf(aiPlayer)), opponent(aiPlayer), aiPlayer, 1, maxDepth,
+                                      -LEVEL_WIN_SCORE, LEVEL_WIN_SCORE, counters);
+            if (noise > 0) {
+                score += (int)(nextNoise(noiseState) % (2 * noise + 1)) - noise;
+            }
+            if (score > bestScore) {
+                bestScore = score;
+                move[0] = k / BOARD_SIZE;
+                move[1] = k % BOARD_SIZE;
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,567 @@
+#include "GameProtocol.h"
+
+#include "Engines.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Tablebase3x3.h" // Outcomes for Analyze and MoveQuality; the sketch also plays from it
+
+static void startGame(GameSession& session, Print& out);
+static void setGameMode(GameSession& session, const char* command, Print& out);
+static void setLevel(GameSession& session, const char* command, Print& out);
+static void setEngine(GameSession& session, const char* command, Print& out);
+static void sendEngineStats(Print& out);
+static void setTelemetry(GameSession& session, const char* command, Print& out);
+#if SEARCH_TELEMETRY
+static void publishTelemetry(const MoveTelemetry& telemetry, Print& out);
+#endif
+static void subscribe(GameSession& session, Print& out);
+static void sendGameState(const GameSession& session, Print& out);
+static void printBoardState(const GameSession& session, Print& out);
+static void publishMove(const GameSession& session, char player, int position, Print& out);
+static void publishResult(GameSession& session, const __FlashStringHelper* result, Print& out);
+static void handleMoves(GameSession& session, const char* command, Print& out);
+static void handleBinaryMoves(GameSession& session, const char* command, Print& out);
+static void applyMoves(GameSession& session, const int positions[], int count, Print& out);
+static void setPosition(GameSession& session, const char* command, Print& out);
+static void analyze(const GameSession& session, Print& out);
+static void handleManvsMan(GameSession& session, const char* command, Print& out);
+static void handleManvsAI(GameSession& session, const char* command, Print& out);
+static void handleAIvsAI(GameSession& session);
+static bool makePlayerMove(GameSession& session, int position, char player, Print& out);
+static void annotateMove(uint32_t before, uint32_t after, char player, Print& out);
+static void requestAIMove(GameSession& session, char player, Print& out);
+static void makeAIMove(GameSession& session, const int aiMove[2], char player, Print& out);
+static bool checkGameStatus(GameSession& session, Print& out);
+static void resetBoard(GameSession& session);
+static void printBoardGraphically(const GameSession& session, Print& out);
+
+static AIMoveScheduler aiMoveScheduler = nullptr;
+
+void setAIMoveScheduler(AIMoveScheduler scheduler) {
+    aiMoveScheduler = scheduler;
+}
+
+// prefix is a PSTR() in flash
+static bool startsWith(const char* text, const char* prefix) {
+    return strncmp_P(text, prefix, strlen_P(prefix)) == 0;
+}
+
+void handleCommand(GameSession& session, const char* command, Print& out) {
+    if (strcmp_P(command, PSTR("StartGame")) == 0) {
+        startGame(session, out);
+    } else if (startsWith(command, PSTR("SetMode "))) {
+        setGameMode(session, command, out);
+    } else if (startsWith(command, PSTR("SetLevel "))) {
+        setLevel(session, command, out);
+    } else if (startsWith(command, PSTR("SetEngine "))) {
+        setEngine(session, command, out);
+    } else if (strcmp_P(command, PSTR("EngineStats")) == 0) {
+        sendEngineStats(out);
+    } else if (startsWith(command, PSTR("Telemetry "))) {
+        setTelemetry(session, command, out);
+    } else if (strcmp_P(command, PSTR("Subscribe")) == 0) {
+        subscribe(session, out);
+    } else if (strcmp_P(command, PSTR("GetGameState")) == 0) {
+        sendGameState(session, out);
+    } else if (startsWith(command, PSTR("Moves "))) {
+        handleMoves(session, command, out);
+    } else if (command[0] == BINARY_COMMAND && command[1] == BINARY_MOVES) {
+        handleBinaryMoves(session, command, out);
+    } else if (startsWith(command, PSTR("SetPosition "))) {
+        setPosition(session, command, out);
+    } else if (strcmp_P(command, PSTR("Analyze")) == 0) {
+        analyze(session, out);
+    }
+
+    if (session.mode == MODE_MAN_VS_MAN) {
+        handleManvsMan(session, command, out);
+    }
+    if (session.mode == MODE_MAN_VS_AI) {
+        handleManvsAI(session, command, out);
+    }
+    if (session.mode == MODE_AI_VS_AI) {
+        handleAIvsAI(session);
+    }
+}
+
+static void startGame(GameSession& session, Print& out) {
+    resetBoard(session);
+    session.isInUse = true;
+    session.isGameStarted = true;
+    session.isResultPublished = false;
+    session.isAutoPlaying = false;
+    if (session.engineX != 0) {
+        resetEngine(session.engineX - 1, session.engineState);
+    }
+    if (session.engineO != 0) {
+        resetEngine(session.engineO - 1, session.engineState);
+    }
+    out.println(F("GameStarted"));
+    printBoardGraphically(session, out);
+}
+
+static void setGameMode(GameSession& session, const char* command, Print& out) {
+    const char* mode = command + 8;
+    session.mode = atoi(mode);
+    out.print(F("Mode set to "));
+    out.println(mode);
+}
+
+// SetLevel <1..5> [seed] - the seed makes the noise of the lower levels repeatable
+static void setLevel(GameSession& session, const char* command, Print& out) {
+    char* end;
+    long level = strtol(command + 9, &end, 10);
+    if (level < 1 || level > MAX_LEVEL) {
+        out.println(F("InvalidLevel"));
+        return;
+    }
+    uint16_t seed = (uint16_t)strtoul(end, nullptr, 10);
+    if (seed != 0) {
+        session.noiseState = seed;
+    } else if (session.noiseState == 0) {
+        session.noiseState = 1; // xorshift never leaves 0
+    }
+    session.level = level;
+    out.print(F("Level set to "));
+    out.println((int)level);
+}
+
+// SetEngine <X|O> <name|default> - AI of one side, "default" returns it to the built-in AI
+static void setEngine(GameSession& session, const char* command, Print& out) {
+    if (strlen(command) <= 12 || command[11] != ' ') {
+        out.println(F("InvalidEngine"));
+        return;
+    }
+    char player = command[10];
+    const char* name = command + 12;
+    uint8_t engine = findEngine(name);
+    if ((player != PLAYER_X && player != PLAYER_O)
+        || (engine == NO_ENGINE && strcmp_P(name, PSTR("default")) != 0)) {
+        out.println(F("InvalidEngine"));
+        return;
+    }
+    uint8_t value = (engine == NO_ENGINE) ? 0 : engine + 1;
+    if (player == PLAYER_X) {
+        session.engineX = value;
+    } else {
+        session.engineO = value;
+    }
+    out.print(F("Engine "));
+    out.print(player);
+    out.print(F(" set to "));
+    out.println(name);
+}
+
+// EngineStats <name> <moves> <nodes> ... for every engine
+static void sendEngineStats(Print& out) {
+    out.print(F("EngineStats"));
+    for (uint8_t engine = 0; engine < engineCount(); engine++) {
+        EngineStats stats = engineStats(engine);
+        out.print(' ');
+        out.print(engineName(engine));
+        out.print(' ');
+        out.print(stats.moves);
+        out.print(' ');
+        out.print((unsigned long)stats.nodes);
+    }
+    out.println();
+}
+
+// Telemetry On|Off; builds with SEARCH_TELEMETRY 0 reply TelemetryDisabled
+static void setTelemetry(GameSession& session, const char* command, Print& out) {
+#if SEARCH_TELEMETRY
+    if (strcmp_P(command + 10, PSTR("On")) == 0 || strcmp_P(command + 10, PSTR("Off")) == 0) {
+        session.isTelemetryOn = (command[11] == 'n');
+        out.print(F("Telemetry "));
+        out.println(command + 10);
+    } else {
+        out.println(F("InvalidTelemetry"));
+    }
+#else
+    out.println(F("TelemetryDisabled"));
+#endif
+}
+
+#if SEARCH_TELEMETRY
+// Telemetry nodes=<n> cutoffs=<n> ttHits=<n> depth=<plies> us=<microseconds>
+static void publishTelemetry(const MoveTelemetry& telemetry, Print& out) {
+    out.print(F("Telemetry nodes="));
+    out.print((unsigned long)telemetry.counters.nodes);
+    out.print(F(" cutoffs="));
+    out.print((unsigned long)telemetry.counters.cutoffs);
+    out.print(F(" ttHits="));
+    out.print((unsigned long)telemetry.counters.ttHits);
+    out.print(F(" depth="));
+    out.print((int)telemetry.counters.maxDepth);
+    out.print(F(" us="));
+    out.println(telemetry.microseconds);
+}
+#endif
+
+static void subscribe(GameSession& session, Print& out) {
+    session.isSubscribed = true;
+    out.println(F("Subscribed"));
+}
+
+static void sendGameState(const GameSession& session, Print& out) {
+    out.print(F("BoardState: "));
+    printBoardState(session, out);
+    out.println();
+}
+
+static void printBoardState(const GameSession& session, Print& out) {
+    for (int k = 0; k < CELL_COUNT; k++) {
+        out.print(cellChar(session.cells, k));
+    }
+}
+
+// Event Move <player> <position> <board>
+static void publishMove(const GameSession& session, char player, int position, Print& out) {
+    if (!session.isSubscribed) {
+        return;
+    }
+    out.print(F("Event Move "));
+    out.print(player);
+    out.print(' ');
+    out.print(position);
+    out.print(' ');
+    printBoardState(session, out);
+    out.println();
+}
+
+// Event Result <X Wins|O Wins|Draw>
+static void publishResult(GameSession& session, const __FlashStringHelper* result, Print& out) {
+    if (!session.isSubscribed || session.isResultPublished) {
+        return;
+    }
+    session.isResultPublished = true;
+    out.print(F("Event Result "));
+    out.println(result);
+}
+
+// Moves 5 1 9 ... - positions separated by spaces
+static void handleMoves(GameSession& session, const char* command, Print& out) {
+    int positions[CELL_COUNT + 1];
+    int count = 0;
+    int value = -1;
+    for (const char* c = command + 6; ; c++) {
+        if (*c >= '0' && *c <= '9') {
+            if (value <= CELL_COUNT) { // Past 9 the move is invalid anyway, longer numbers would overflow
+                value = (value < 0 ? 0 : value * 10) + (*c - '0');
+            }
+        } else if (value >= 0) {
+            positions[count++] = value;
+            value = -1;
+            if (count > CELL_COUNT) {
+                break;
+            }
+        }
+        if (*c == '\0') {
+            break;
+        }
+    }
+    applyMoves(session, positions, count, out);
+}
+
+// 0x01 'M' followed by one raw byte (1..9) per move
+static void handleBinaryMoves(GameSession& session, const char* command, Print& out) {
+    int positions[CELL_COUNT + 1];
+    int count = 0;
+    for (const char* c = command + 2; *c != '\0' && count <= CELL_COUNT; c++) {
+        positions[count++] = (unsigned char)*c;
+    }
+    applyMoves(session, positions, count, out);
+}
+
+// Applies the whole sequence or nothing. Replies with the final state,
+// or "InvalidMove <index>" for the first illegal move (0-based)
+static void applyMoves(GameSession& session, const int positions[], int count, Print& out) {
+    if (!session.isGameStarted) {
+        out.println(F("InvalidMove 0"));
+        return;
+    }
+
+    uint32_t cells = session.cells;
+    char player = sideToMove(cells);
+    for (int k = 0; k < count; k++) {
+        if (k >= CELL_COUNT || checkWin(cells, PLAYER_X) || checkWin(cells, PLAYER_O) || !isPositionValid(cells, positions[k])) {
+            out.print(F("InvalidMove "));
+            out.println(k);
+            return;
+        }
+        cells = withCell(cells, positions[k] - 1, pieceOf(player));
+        player = opponent(player);
+    }
+
+    session.cells = cells;
+    sendGameState(session, out);
+    checkGameStatus(session, out);
+}
+
+// SetPosition XO3.5.789 - 'X'/'O' are marks, any other char is an empty cell
+static void setPosition(GameSession& session, const char* command, Print& out) {
+    const char* position = command + 12;
+    if (strlen(position) != CELL_COUNT) {
+        out.println(F("InvalidPosition"));
+        return;
+    }
+
+    uint32_t cells = EMPTY_BOARD;
+    for (int k = 0; k < CELL_COUNT; k++) {
+        if (position[k] == PLAYER_X || position[k] == PLAYER_O) {
+            cells = withCell(cells, k, pieceOf(position[k]));
+        }
+    }
+    int difference = countPieces(cells, CELL_X) - countPieces(cells, CELL_O);
+    if (difference != 0 && difference != 1) {
+        out.println(F("InvalidPosition"));
+        return;
+    }
+
+    session.cells = cells;
+    session.isGameStarted = true;
+    session.isResultPublished = false;
+    session.isAutoPlaying = false;
+    session.lastServerMove = -1;
+    sendGameState(session, out);
+    checkGameStatus(session, out);
+}
+
+// Score of every empty cell for the side to move, in minimax() units; occupied cells get
+// SCORE_NONE. One pass over the moves: with the 3x3 table the outcome of each move is
+// probed first, draws need no search and wins/losses only search their half of the window
+const int8_t SCORE_NONE = -128;
+
+static void analyzeMoves(uint32_t cells, char player, int8_t scores[CELL_COUNT]) {
+    for (int k = 0; k < CELL_COUNT; k++) {
+        scores[k] = SCORE_NONE;
+        if (cellAt(cells, k) == CELL_EMPTY) {
+            uint32_t child = withCell(cells, k, pieceOf(player));
+            int alpha = SCORE_LOWER_BOUND;
+            int beta = SCORE_UPPER_BOUND;
+#ifdef TABLEBASE_3X3
+            uint8_t value = checkWin(child, player) ? TABLEBASE_LOSS
+                : probeBlockTablebase(TABLEBASE_3X3, positionIndex(child));
+            if (value == TABLEBASE_DRAW) {
+                beta = alpha = 0;
+            } else if (value == TABLEBASE_LOSS) { // Lost for the opponent
+                alpha = 0;
+            } else {
+                beta = 0;
+            }
+#endif
+            scores[k] = (alpha == beta) ? alpha : alphaBeta(child, opponent(player), player, 0, alpha, beta);
+        }
+    }
+}
+
+// Analysis <player> <9 scores, '.' for occupied cells>, or Analysis GameOver
+static void analyze(const GameSession& session, Print& out) {
+    out.print(F("Analysis "));
+    if (isGameOver(session.cells)) {
+        out.println(F("GameOver"));
+        return;
+    }
+    char player = sideToMove(session.cells);
+    int8_t scores[CELL_COUNT];
+    analyzeMoves(session.cells, player, scores);
+    out.print(player);
+    for (int k = 0; k < CELL_COUNT; k++) {
+        out.print(' ');
+        if (scores[k] == SCORE_NONE) {
+            out.print('.');
+        } else {
+            out.print((int)scores[k]);
+        }
+    }
+    out.println();
+}
+
+static void handleManvsMan(GameSession& session, const char* command, Print& out) {
+    if (startsWith(command, PSTR("Move ")) && session.isGameStarted) {
+        int position = atoi(command + 5);
+
+        char player = sideToMove(session.cells);
+
+        if (makePlayerMove(session, position, player, out)) {
+            printBoardGraphically(session, out);
+            checkGameStatus(session, out);
+        } else {
+            out.println(F("InvalidMove"));
+        }
+    }
+}
+
+static void handleManvsAI(GameSession& session, const char* command, Print& out) {
+    if (startsWith(command, PSTR("Move ")) && session.isGameStarted) {
+        int position = atoi(command + 5);
+        uint32_t before = session.cells;
+
+        if (makePlayerMove(session, position, PLAYER_X, out)) {
+            annotateMove(before, session.cells, PLAYER_X, out);
+            if (!checkGameStatus(session, out)) {
+                requestAIMove(session, PLAYER_O, out);
+            }
+        } else {
+            out.println(F("InvalidMove"));
+        }
+    }
+}
+
+// Result for player with perfect play from here: 1 - win, 0 - draw, -1 - loss.
+// Probes the 3x3 table, without it a search with the window (-1, 1)
+static int outcomeFor(uint32_t cells, char player) {
+    if (checkWin(cells, player)) {
+        return 1;
+    } else if (checkWin(cells, opponent(player))) {
+        return -1;
+    } else if (isBoardFull(cells)) {
+        return 0;
+    }
+#ifdef TABLEBASE_3X3
+    uint8_t value = probeBlockTablebase(TABLEBASE_3X3, positionIndex(cells));
+    int outcome = (value == TABLEBASE_WIN) ? 1 : (value == TABLEBASE_LOSS) ? -1 : 0;
+    return (sideToMove(cells) == player) ? outcome : -outcome;
+#else
+    int score = alphaBeta(cells, sideToMove(cells), player, 0, -1, 1);
+    return (score > 0) - (score < 0);
+#endif
+}
+
+// MoveQuality <Optimal|Mistake|Blunder>: a mistake gives away a won game,
+// a blunder turns a won or drawn game into a loss
+static void annotateMove(uint32_t before, uint32_t after, char player, Print& out) {
+    int best = outcomeFor(before, player);
+    int played = outcomeFor(after, player);
+    out.print(F("MoveQuality "));
+    if (played >= best) {
+        out.println(F("Optimal"));
+    } else if (played == 0) {
+        out.println(F("Mistake"));
+    } else {
+        out.println(F("Blunder"));
+    }
+}
+
+// AI vs AI games are played one move per AI_VS_AI_MOVE_DELAY by stepAIvsAI,
+// so a running game does not block the other sessions
+static void handleAIvsAI(GameSession& session) {
+    if (session.isGameStarted && !isGameOver(session.cells)) {
+        session.isAutoPlaying = true;
+    }
+}
+
+void stepAIvsAI(GameSession& session, Print& out) {
+    if (session.isAIThinking) {  // Попередній хід ще рахується
+        return;
+    }
+    if (checkGameStatus(session, out)) {  // Гра вже закінчилась
+        session.isAutoPlaying = false;
+        return;
+    }
+
+    requestAIMove(session, sideToMove(session.cells), out);  // Виконуємо хід поточного гравця
+}
+
+// Computes the AI move inline unless the scheduler hands it off to another thread.
+// The lower levels always run inline, they search 4 plies at most
+static void requestAIMove(GameSession& session, char player, Print& out) {
+    uint8_t engine = (player == PLAYER_X) ? session.engineX : session.engineO;
+    bool isLowerLevel = (engine == 0 && session.level != 0 && session.level < MAX_LEVEL);
+    if (!isLowerLevel && aiMoveScheduler && aiMoveScheduler(session, player, out)) {
+        session.isAIThinking = true;
+        return;
+    }
+
+    int aiMove[2];
+    MoveTelemetry telemetry = MoveTelemetry();
+#if SEARCH_TELEMETRY
+    unsigned long start = micros();
+#endif
+    if (engine != 0) {
+        chooseEngineMove(engine - 1, session.cells, player, session.engineState, aiMove, &telemetry.counters);
+    } else if (isLowerLevel) {
+        levelMove(session.cells, player, session.level, session.noiseState, aiMove, &telemetry.counters);
+    } else {
+#if defined(ARDUINO) && defined(TABLEBASE_3X3) // The host keeps the moves of its search workers
+        tablebaseBestMove(TABLEBASE_3X3, session.cells, player, aiMove, &telemetry.counters);
+#else
+        bestMove(session.cells, player, aiMove, &telemetry.counters);
+#endif
+    }
+#if SEARCH_TELEMETRY
+    telemetry.microseconds = micros() - start;
+#endif
+    applyAIMove(session, aiMove, player, out, &telemetry);
+}
+
+void applyAIMove(GameSession& session, const int aiMove[2], char player, Print& out, const MoveTelemetry* telemetry) {
+    session.isAIThinking = false;
+    makeAIMove(session, aiMove, player, out);
+#if SEARCH_TELEMETRY
+    if (session.isTelemetryOn && telemetry) {
+        publishTelemetry(*telemetry, out);
+    }
+#endif
+    printBoardGraphically(session, out);
+
+    // Перевіряємо статус гри після кожного ходу
+    if (checkGameStatus(session, out)) {
+        session.isAutoPlaying = false;
+    }
+}
+
+static bool makePlayerMove(GameSession& session, int position, char player, Print& out) {
+    if (isPositionValid(session.cells, position)) {
+        session.cells = withCell(session.cells, position - 1, pieceOf(player));
+        publishMove(session, player, position, out);
+        return true;
+    }
+    return false;
+}
+
+static void makeAIMove(GameSession& session, const int aiMove[2], char player, Print& out) {
+    session.cells = withCell(session.cells, aiMove[0] * BOARD_SIZE + aiMove[1], pieceOf(player));
+    session.lastServerMove = aiMove[0] * BOARD_SIZE + aiMove[1] + 1;
+    out.print(F("ServerMove: "));
+    out.println((int)session.lastServerMove);
+    publishMove(session, player, session.lastServerMove, out);
+}
+
+static bool checkGameStatus(GameSession& session, Print& out) {
+    if (checkWin(session.cells, PLAYER_X)) {
+        out.println(F("X Wins"));
+        publishResult(session, F("X Wins"), out);
+        return true;
+    } else if (checkWin(session.cells, PLAYER_O)) {
+        out.println(F("O Wins"));
+        publishResult(session, F("O Wins"), out);
+        return true;
+    } else if (isBoardFull(session.cells)) {
+        out.println(F("Draw"));
+        publishResult(session, F("Draw"), out);
+        return true;
+    }
+    return false;
+}
+
+static void resetBoard(GameSession& session) {
+    session.cells = EMPTY_BOARD;
+    session.lastServerMove = -1;
+}
+
+static void printBoardGraphically(const GameSession& session, Print& out) {
+    out.println(F("-------------"));
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        out.print(F("| "));
+        for (int j = 0; j < BOARD_SIZE; j++) {
+            out.print(cellChar(session.cells, i * BOARD_SIZE + j));
+            out.print(F(" | "));
+        }
+        out.println();
+        out.println(F("-------------"));
+    }
+    out.println(); // Blank line after board output
+}
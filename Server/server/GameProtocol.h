@@ -0,0 +1,64 @@
+#ifndef GAME_PROTOCOL_H
+#define GAME_PROTOCOL_H
+
+// Text command protocol of one game session. The sketch feeds it from the UART,
+// the host server from its socket connections; replies go to the given Print.
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include "HostPrint.h"
+#endif
+
+#include "GameCore.h"
+
+const int MODE_MAN_VS_MAN = 1;
+const int MODE_MAN_VS_AI = 2;
+const int MODE_AI_VS_AI = 3;
+const char BINARY_COMMAND = 0x01; // Binary command prefix, followed by an opcode
+const char BINARY_MOVES = 'M';    // 0x01 'M' <position bytes 1..9> '\n'
+
+const unsigned long AI_VS_AI_MOVE_DELAY = 500; // ms between moves of AI vs AI games
+
+// One game slot. The board fits into 18 bits, so the whole session is 11 bytes
+struct GameSession {
+    uint32_t cells : 18;
+    uint32_t isInUse : 1;
+    uint32_t isGameStarted : 1;
+    uint32_t isSubscribed : 1;      // Push move/result events to the client
+    uint32_t isResultPublished : 1; // Result event is sent only once per game
+    uint32_t isAutoPlaying : 1;     // AI vs AI game in progress
+    uint32_t isAIThinking : 1;      // AI move is being computed by an AIMoveScheduler
+    uint32_t level : 3;             // SetLevel 1..MAX_LEVEL, 0 - not set, plays as MAX_LEVEL
+    uint32_t isTelemetryOn : 1;     // "Telemetry ..." line after every AI move
+    uint8_t mode;                   // 1 - Man vs Man, 2 - Man vs AI, 3 - AI vs AI
+    int8_t lastServerMove;          // Last move of the AI
+    uint8_t engineX : 4;            // SetEngine: engine number + 1, 0 - the default AI
+    uint8_t engineO : 4;
+    uint16_t noiseState;            // Noise of the lower levels, seeded by SetLevel
+    uint16_t engineState;           // Search state of the SetEngine engines, reset by StartGame
+};
+
+// Counters of one AI move for the Telemetry line
+struct MoveTelemetry {
+    SearchCounters counters;
+    unsigned long microseconds;
+};
+
+// Host builds may compute AI moves off the calling thread. The scheduler returns true
+// if it took over the search; the move is then finished later with applyAIMove().
+// The search is bestMove() or the engine picked with SetEngine for player.
+// Without a scheduler (the sketch) it runs inline.
+typedef bool (*AIMoveScheduler)(GameSession& session, char player, Print& out);
+void setAIMoveScheduler(AIMoveScheduler scheduler);
+
+// Plays the AI move {row, col} found for player and reports the result
+void applyAIMove(GameSession& session, const int aiMove[2], char player, Print& out, const MoveTelemetry* telemetry = 0);
+
+// Handles one command line (without the trailing '\n')
+void handleCommand(GameSession& session, const char* command, Print& out);
+
+// Plays the next move of a running AI vs AI game, called every AI_VS_AI_MOVE_DELAY
+void stepAIvsAI(GameSession& session, Print& out);
+
+#endif
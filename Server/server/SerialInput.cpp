@@ -0,0 +1,126 @@
+#include "SerialInput.h"
+
+// 1/16 of SRAM: 128 bytes on the Uno on top of the core's 64, 512 on the Mega
+#ifndef SERIAL_INPUT_SIZE
+#if defined(RAMEND) && defined(RAMSTART)
+#define SERIAL_INPUT_SIZE ((RAMEND - RAMSTART + 1) / 16)
+#else
+#define SERIAL_INPUT_SIZE 128
+#endif
+#endif
+
+const uint16_t XOFF_LEVEL = SERIAL_INPUT_SIZE * 3 / 4;
+const uint16_t XON_LEVEL = SERIAL_INPUT_SIZE / 4;
+
+// Timer0 runs millis() from its overflow; its compare match A is free and fires once per overflow
+#if defined(TIMER0_COMPA_vect)
+#define SERIAL_INPUT_TIMER 1
+#else
+#define SERIAL_INPUT_TIMER 0
+#endif
+
+// The interrupt sends XOFF itself when UDR0 is free, so a long search cannot overrun the ring
+#if SERIAL_INPUT_TIMER && defined(UDR0)
+#define SERIAL_INPUT_DIRECT_TX 1
+#else
+#define SERIAL_INPUT_DIRECT_TX 0
+#endif
+
+static uint8_t ring[SERIAL_INPUT_SIZE];
+static volatile uint16_t head = 0;              // Next byte to write
+static volatile uint16_t tail = 0;              // Next byte to read
+static volatile uint16_t count = 0;
+static volatile bool isPaused = false;          // XOFF is sent or pending
+static volatile uint8_t pendingFlowControl = 0; // XON or XOFF waiting for the transmitter
+static volatile SerialInputStats inputStats = { 0, 0 };
+
+// Runs with interrupts disabled
+static void drain() {
+    while (Serial.available() > 0) {
+        uint8_t c = Serial.read();
+        if (count == SERIAL_INPUT_SIZE) {
+            inputStats.dropped++;
+            continue;
+        }
+        ring[head] = c;
+        head = (head + 1) % SERIAL_INPUT_SIZE;
+        count++;
+    }
+    if (count > inputStats.highWater) {
+        inputStats.highWater = count;
+    }
+    if (!isPaused && count >= XOFF_LEVEL) {
+        isPaused = true;
+        pendingFlowControl = XOFF;
+    }
+}
+
+#if SERIAL_INPUT_TIMER
+// A pending XON/XOFF goes straight into UDR0 when it is empty and waits for the next tick
+// otherwise. writeSerialOutput() masks this interrupt around every byte of loop(), so it
+// never lands between the core's UDRE0 check and its write to UDR0
+ISR(TIMER0_COMPA_vect) {
+    drain();
+#if SERIAL_INPUT_DIRECT_TX
+    if (pendingFlowControl != 0 && bit_is_set(UCSR0A, UDRE0)) {
+        UDR0 = pendingFlowControl;
+        pendingFlowControl = 0;
+    }
+#endif
+}
+#endif
+
+void beginSerialInput() {
+#if SERIAL_INPUT_TIMER
+    OCR0A = 0x80;
+    TIMSK0 |= _BV(OCIE0A);
+#endif
+}
+
+void pollSerialInput() {
+    noInterrupts();
+    drain();
+    uint8_t flowControl = pendingFlowControl;
+    pendingFlowControl = 0;
+    interrupts();
+    if (flowControl != 0) {
+        writeSerialOutput(&flowControl, 1);
+    }
+}
+
+void writeSerialOutput(const uint8_t* data, uint16_t size) {
+#if SERIAL_INPUT_DIRECT_TX
+    // Per byte: a full TX ring blocks for one byte time, the core's 64-byte receive buffer covers it
+    for (uint16_t k = 0; k < size; k++) {
+        TIMSK0 &= ~_BV(OCIE0A);
+        Serial.write(data[k]);
+        TIMSK0 |= _BV(OCIE0A);
+    }
+#else
+    Serial.write(data, size);
+#endif
+}
+
+int readSerialInput() {
+    noInterrupts();
+    if (count == 0) {
+        interrupts();
+        return -1;
+    }
+    uint8_t c = ring[tail];
+    tail = (tail + 1) % SERIAL_INPUT_SIZE;
+    count--;
+    if (isPaused && count <= XON_LEVEL) {
+        isPaused = false;
+        pendingFlowControl = XON; // Replaces an XOFF that has not gone out yet
+    }
+    interrupts();
+    return c;
+}
+
+SerialInputStats serialInputStats() {
+    noInterrupts();
+    SerialInputStats copy = { inputStats.highWater, inputStats.dropped };
+    interrupts();
+    return copy;
+}
@@ -0,0 +1,36 @@
+#ifndef SERIAL_INPUT_H
+#define SERIAL_INPUT_H
+
+// Receive ring of the sketch in front of the core's 64-byte Serial buffer. A timer
+// interrupt moves every received byte into the ring once per millisecond, so commands
+// pipelined by the client survive a long bestMove() search. The ring asks the client to
+// pause with XOFF when it is 3/4 full and to resume with XON once it drains to 1/4.
+// The ATmega UARTs have no RTS/CTS lines, so XON/XOFF is the only flow control.
+
+#include <Arduino.h>
+
+const uint8_t XON = 0x11;
+const uint8_t XOFF = 0x13;
+
+struct SerialInputStats {
+    uint16_t highWater; // Most bytes waiting in the ring
+    uint16_t dropped;   // Bytes lost because the ring was full
+};
+
+// Once in setup(), after Serial.begin()
+void beginSerialInput();
+
+// Moves the received bytes into the ring and sends a pending XON/XOFF; loop() calls it.
+// During a search the timer interrupt sends XOFF itself once the ring is 3/4 full
+void pollSerialInput();
+
+// Next byte from the ring, -1 if it is empty
+int readSerialInput();
+
+SerialInputStats serialInputStats();
+
+// Every byte the sketch sends goes through here instead of Serial.write(), so the
+// interrupt's XOFF cannot collide with it in UDR0
+void writeSerialOutput(const uint8_t* data, uint16_t size);
+
+#endif
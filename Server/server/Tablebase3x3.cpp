@@ -0,0 +1,208 @@
+// Generated by tablebase_compress: 3x3, 3 in a row, BlockTablebase.h format
+
+#include "Tablebase3x3.h"
+
+const uint8_t tablebase3x3[3219] PROGMEM = {
+    0x54, 0x54, 0x54, 0x43, 0x01, 0x03, 0x03, 0x09, 0xE3, 0x4C, 0x00, 0x00, 0x27, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x80, 0x6B, 0x00, 0x00, 0x80, 0xCA, 0x00, 0x00, 0x80, 0x25, 0x01, 0x00, 0x80,
+    0x76, 0x01, 0x00, 0x80, 0xCF, 0x01, 0x00, 0x80, 0x3A, 0x02, 0x00, 0x80, 0x7D, 0x02, 0x00, 0x80,
+    0xF2, 0x02, 0x00, 0x80, 0x52, 0x03, 0x00, 0x80, 0xAB, 0x03, 0x00, 0x80, 0x2A, 0x04, 0x00, 0x80,
+    0x5A, 0x04, 0x00, 0x80, 0x8B, 0x04, 0x00, 0x80, 0xEC, 0x04, 0x00, 0x80, 0x34, 0x05, 0x00, 0x80,
+    0xA0, 0x05, 0x00, 0x80, 0xF6, 0x05, 0x00, 0x80, 0x2A, 0x06, 0x00, 0x80, 0x5C, 0x06, 0x00, 0x80,
+    0x6B, 0x06, 0x00, 0x80, 0xC2, 0x06, 0x00, 0x80, 0x35, 0x07, 0x00, 0x80, 0x99, 0x07, 0x00, 0x80,
+    0xFD, 0x07, 0x00, 0x80, 0x54, 0x08, 0x00, 0x80, 0x90, 0x08, 0x00, 0x80, 0xD4, 0x08, 0x00, 0x80,
+    0x46, 0x09, 0x00, 0x80, 0x79, 0x09, 0x00, 0x80, 0xA1, 0x09, 0x00, 0x80, 0x1A, 0x0A, 0x00, 0x80,
+    0x83, 0x0A, 0x00, 0x80, 0xE6, 0x0A, 0x00, 0x80, 0x47, 0x0B, 0x00, 0x80, 0x63, 0x0B, 0x00, 0x80,
+    0x9C, 0x0B, 0x00, 0x80, 0xD7, 0x0B, 0x00, 0x80, 0xDF, 0x0B, 0x00, 0x80, 0xE3, 0x0B, 0x00, 0x00,
+    0xC6, 0x41, 0xC1, 0x44, 0xC2, 0x41, 0xC0, 0x44, 0xC5, 0x40, 0x83, 0xC5, 0x41, 0x81, 0x49, 0x84,
+    0x40, 0x81, 0x41, 0x81, 0x4A, 0xC5, 0x40, 0x83, 0xC3, 0x81, 0x40, 0xC4, 0x45, 0xC3, 0x81, 0x48,
+    0x80, 0xC1, 0x42, 0x80, 0x40, 0x81, 0x40, 0x83, 0x43, 0x81, 0x44, 0x82, 0x42, 0x85, 0xE0, 0x41,
+    0xC4, 0x40, 0xC0, 0x44, 0xC0, 0x51, 0x8D, 0xC1, 0x44, 0xC3, 0x85, 0x40, 0xC4, 0x54, 0x80, 0x46,
+    0x81, 0xC4, 0x43, 0xC1, 0x44, 0xD0, 0x81, 0x48, 0x80, 0xC1, 0x42, 0x80, 0x40, 0x9C, 0xC4, 0x41,
+    0xC3, 0x43, 0x81, 0x40, 0xC4, 0x43, 0xCA, 0x47, 0xC2, 0x46, 0x82, 0x40, 0x80, 0x4A, 0x80, 0x43,
+    0x81, 0x45, 0xC4, 0x40, 0x83, 0x47, 0xC5, 0x48, 0x83, 0x47, 0x83, 0xC7, 0x41, 0xC5, 0x40, 0xC2,
+    0x54, 0x8D, 0x40, 0x83, 0x43, 0x81, 0x42, 0x80, 0x40, 0x82, 0x47, 0xC5, 0x40, 0x83, 0xC5, 0x40,
+    0xC0, 0x4B, 0x84, 0x40, 0x83, 0x59, 0x8E, 0x42, 0x84, 0x40, 0x81, 0xC3, 0x65, 0xC1, 0x42, 0xC0,
+    0x40, 0x87, 0xC1, 0x41, 0x81, 0xC1, 0x4B, 0x88, 0x42, 0x82, 0x41, 0x81, 0x40, 0xC3, 0x43, 0xC1,
+    0x51, 0xC3, 0x81, 0x48, 0x80, 0xC5, 0x40, 0x89, 0x51, 0x82, 0x42, 0x80, 0x40, 0x8A, 0x40, 0xC3,
+    0x43, 0xC6, 0x41, 0xC1, 0x43, 0xC0, 0x44, 0xCA, 0x41, 0x83, 0x45, 0x80, 0x40, 0x81, 0xC9, 0x44,
+    0xC0, 0x43, 0x87, 0xCC, 0x48, 0x80, 0xC5, 0x40, 0x89, 0x50, 0x81, 0xC1, 0x42, 0x80, 0x40, 0xC3,
+    0x85, 0x40, 0xC4, 0x5D, 0x9D, 0xC5, 0x48, 0x80, 0xCA, 0x43, 0xC0, 0x4A, 0xC6, 0x49, 0x88, 0x42,
+    0x82, 0x41, 0x81, 0x40, 0xC3, 0x41, 0xC3, 0x47, 0xC7, 0x40, 0x81, 0xC1, 0x43, 0xC1, 0x44, 0x82,
+    0x47, 0xC4, 0x41, 0x83, 0xC3, 0x81, 0x41, 0x81, 0x41, 0xC4, 0x54, 0x86, 0x42, 0x80, 0x40, 0x8A,
+    0x4E, 0x81, 0x48, 0x80, 0x41, 0x82, 0x41, 0x81, 0x40, 0x83, 0x43, 0x89, 0x4A, 0xC0, 0x44, 0xC0,
+    0x43, 0x81, 0x4B, 0x81, 0xCA, 0x41, 0x84, 0x40, 0xA0, 0x42, 0x84, 0x40, 0x81, 0x41, 0x81, 0x4A,
+    0xC0, 0x47, 0xC1, 0x5C, 0x8A, 0xC7, 0x43, 0xC4, 0x41, 0xC2, 0x42, 0x84, 0xC1, 0x42, 0x80, 0x40,
+    0x83, 0xC5, 0x41, 0x83, 0x47, 0x84, 0x40, 0x81, 0x41, 0x81, 0x57, 0x8E, 0xC2, 0x44, 0xCC, 0x9F,
+    0x40, 0xC1, 0x41, 0x81, 0x48, 0xC2, 0x52, 0x85, 0x4D, 0x84, 0x40, 0x81, 0x41, 0x81, 0x4A, 0xC1,
+    0x44, 0x83, 0x43, 0x81, 0x41, 0x83, 0x45, 0x98, 0xC2, 0x41, 0x81, 0x43, 0x83, 0x40, 0xC2, 0x42,
+    0x85, 0x48, 0x83, 0x47, 0x85, 0x43, 0x83, 0x49, 0x8B, 0x48, 0x91, 0x48, 0x8E, 0xC2, 0x44, 0xCC,
+    0xA0, 0x42, 0x84, 0x40, 0x83, 0x48, 0xC4, 0x41, 0xC1, 0x43, 0xC9, 0x54, 0xAC, 0x48, 0xA8, 0xC1,
+    0x43, 0xCA, 0x41, 0xC1, 0x4B, 0xC1, 0x48, 0x80, 0x41, 0x82, 0x41, 0x81, 0x40, 0xC1, 0x45, 0xC1,
+    0x44, 0xC2, 0x49, 0xD1, 0x42, 0x80, 0xCA, 0x51, 0x82, 0x42, 0x80, 0x40, 0xC3, 0x43, 0xC1, 0x41,
+    0x85, 0x41, 0xC2, 0x41, 0x81, 0x41, 0xC1, 0x44, 0xC2, 0x41, 0x80, 0x44, 0xC4, 0x41, 0xC3, 0x43,
+    0xC1, 0x45, 0x81, 0x42, 0xC1, 0x80, 0x44, 0xC0, 0x43, 0x81, 0xC5, 0x86, 0x43, 0xC1, 0x48, 0x80,
+    0x41, 0x82, 0x41, 0x89, 0x51, 0x80, 0xC1, 0x44, 0xC3, 0x43, 0xC1, 0x40, 0xC4, 0x5D, 0x96, 0x4C,
+    0x88, 0x40, 0xC1, 0x42, 0x80, 0xC4, 0x44, 0xC3, 0x43, 0xC1, 0x40, 0xC0, 0x43, 0x81, 0x49, 0x88,
+    0x42, 0x82, 0x40, 0x80, 0x42, 0xC1, 0x41, 0x81, 0x41, 0xC1, 0x44, 0xC5, 0x45, 0xC1, 0x45, 0xC1,
+    0x44, 0xC2, 0x47, 0xC5, 0x40, 0xC9, 0x64, 0x81, 0x42, 0x80, 0x40, 0xC3, 0x83, 0xC1, 0x43, 0x83,
+    0x43, 0xC3, 0x41, 0xC9, 0x44, 0x81, 0x42, 0x85, 0x41, 0x81, 0x42, 0x80, 0x40, 0x82, 0x42, 0x85,
+    0xC1, 0x80, 0x44, 0xC0, 0x43, 0x81, 0xC5, 0x84, 0x40, 0xC1, 0x41, 0xC1, 0x41, 0xC4, 0x41, 0xC2,
+    0x41, 0x80, 0x48, 0x9C, 0xC1, 0x48, 0x80, 0x44, 0x80, 0x40, 0x89, 0x51, 0x82, 0x42, 0x80, 0x40,
+    0xC3, 0x85, 0x41, 0xC1, 0x81, 0x5D, 0xA3, 0x48, 0x82, 0x40, 0x82, 0x40, 0xC3, 0x44, 0x83, 0x43,
+    0xC1, 0x41, 0x81, 0x4B, 0x81, 0x49, 0x81, 0x44, 0x81, 0x74, 0xA1, 0xC1, 0x48, 0x80, 0xC1, 0x42,
+    0x80, 0x40, 0xFF, 0x51, 0x82, 0x43, 0xC1, 0x49, 0xC1, 0x44, 0x89, 0x51, 0x80, 0xC1, 0x44, 0xC3,
+    0x43, 0xC1, 0x41, 0xC3, 0x48, 0x80, 0x40, 0x89, 0x4F, 0x81, 0x48, 0x80, 0x46, 0x81, 0x5C, 0x85,
+    0x48, 0x80, 0x44, 0x80, 0x5C, 0x82, 0x42, 0x80, 0x40, 0x8A, 0x42, 0x83, 0x55, 0x46, 0x81, 0x44,
+    0x83, 0x43, 0x81, 0x41, 0x81, 0x46, 0x99, 0xC2, 0x43, 0xC6, 0x40, 0xC3, 0x47, 0xC1, 0x43, 0xCA,
+    0x4D, 0x84, 0x40, 0x81, 0x41, 0x81, 0x4A, 0xC1, 0x42, 0x80, 0xC4, 0x43, 0xC2, 0x40, 0x85, 0x43,
+    0x83, 0xC1, 0x48, 0xC0, 0x81, 0x42, 0x80, 0x40, 0x81, 0x40, 0x85, 0x43, 0x83, 0xC3, 0x42, 0x85,
+    0xC1, 0x80, 0x44, 0xC2, 0x41, 0x81, 0xC5, 0x84, 0xC0, 0x43, 0x81, 0xC6, 0x40, 0xC3, 0x8B, 0x48,
+    0x8D, 0x41, 0x82, 0x40, 0xC4, 0x43, 0xC1, 0x4F, 0xC1, 0x48, 0x80, 0x49, 0x81, 0x41, 0x81, 0x43,
+    0x83, 0x40, 0xC2, 0x4D, 0xC1, 0x49, 0x81, 0x42, 0x80, 0x40, 0x9C, 0x41, 0x83, 0xC8, 0x41, 0x80,
+    0x40, 0x85, 0x41, 0xC0, 0x43, 0x81, 0xC3, 0x44, 0xC2, 0x87, 0x41, 0x82, 0x40, 0xC0, 0x47, 0xC1,
+    0x40, 0x80, 0x88, 0x41, 0x80, 0x45, 0x81, 0x41, 0x81, 0x45, 0x85, 0x42, 0x84, 0x40, 0xC1, 0x81,
+    0x41, 0xC5, 0x44, 0xC0, 0x41, 0xC1, 0x41, 0xCB, 0x81, 0x52, 0x8D, 0x40, 0x85, 0x41, 0xC1, 0x42,
+    0x80, 0xC3, 0x42, 0x84, 0xC1, 0x42, 0x80, 0xCB, 0x42, 0x83, 0x45, 0x84, 0x40, 0x85, 0x57, 0x8E,
+    0xC2, 0x44, 0xCC, 0xA0, 0x41, 0xC5, 0x40, 0x81, 0xC3, 0x45, 0xC4, 0x42, 0xC3, 0x41, 0xC1, 0x49,
+    0xC0, 0x51, 0x8D, 0x40, 0x81, 0xC3, 0x41, 0x81, 0x44, 0x82, 0x41, 0xC0, 0x44, 0x81, 0x42, 0xC0,
+    0x40, 0x89, 0x41, 0x81, 0xC1, 0x47, 0x84, 0x40, 0x83, 0x59, 0x8E, 0x42, 0x84, 0xC0, 0x41, 0xC3,
+    0x85, 0x56, 0x49, 0xC5, 0x4D, 0xC0, 0x49, 0xC0, 0x44, 0x83, 0x43, 0x81, 0xC1, 0x47, 0xC4, 0x40,
+    0x83, 0x47, 0xC4, 0x81, 0x42, 0xC0, 0x40, 0x89, 0x41, 0x81, 0xC1, 0x45, 0x98, 0x40, 0xC1, 0x41,
+    0xC1, 0x41, 0x81, 0x44, 0x82, 0x41, 0xC8, 0x40, 0xC4, 0x42, 0x81, 0x41, 0x85, 0xC4, 0x80, 0x43,
+    0xC1, 0x81, 0x45, 0x83, 0x41, 0xC0, 0x51, 0x91, 0x48, 0x8E, 0x42, 0x84, 0x40, 0x81, 0xC3, 0x69,
+    0x84, 0x40, 0x83, 0x4D, 0x81, 0x41, 0xC1, 0x41, 0xC1, 0x42, 0xC0, 0x40, 0x82, 0x41, 0xC0, 0x51,
+    0xAC, 0x48, 0xA8, 0x40, 0x81, 0xC3, 0x41, 0xC1, 0x42, 0xC0, 0x41, 0x43, 0xC5, 0x81, 0x42, 0xC0,
+    0x40, 0x83, 0x47, 0x81, 0xC6, 0x42, 0xC4, 0x40, 0x83, 0x47, 0xC4, 0x81, 0x42, 0xC0, 0x40, 0x8A,
+    0x40, 0x81, 0xC3, 0x43, 0x85, 0x48, 0x82, 0x42, 0xC0, 0x40, 0x81, 0x40, 0x81, 0xC1, 0x43, 0x89,
+    0x41, 0xC6, 0x42, 0x84, 0xC0, 0x41, 0xC3, 0x85, 0x45, 0x81, 0xC5, 0x41, 0x82, 0x40, 0x85, 0x40,
+    0x88, 0x48, 0x8D, 0xC1, 0x42, 0xC0, 0x44, 0x83, 0x43, 0xC5, 0x53, 0x81, 0x42, 0xC0, 0x40, 0x81,
+    0x40, 0xC3, 0x43, 0x81, 0x42, 0x80, 0x43, 0xC9, 0x85, 0x48, 0x80, 0xC1, 0x42, 0xC0, 0x40, 0x9C,
+    0xC1, 0x42, 0xC0, 0x40, 0x8A, 0xC6, 0x41, 0xC0, 0x41, 0xC3, 0x81, 0x45, 0x83, 0x41, 0xC5, 0x41,
+    0x82, 0x40, 0x84, 0x45, 0x80, 0x40, 0x81, 0xC8, 0x40, 0xC4, 0x42, 0x81, 0x41, 0x85, 0xC5, 0x42,
+    0x84, 0x40, 0x83, 0x4D, 0x81, 0xC5, 0x81, 0x42, 0xC0, 0x40, 0x84, 0x40, 0x88, 0x48, 0x8D, 0x40,
+    0x81, 0xC1, 0x43, 0x89, 0x41, 0xC0, 0x44, 0x81, 0x42, 0xC0, 0x40, 0x8A, 0x40, 0x81, 0x41, 0xC4,
+    0x42, 0x91, 0x51, 0x90, 0x40, 0x84, 0x40, 0x81, 0xED, 0x48, 0x90, 0x4A, 0xC1, 0xA6, 0x41, 0xC0,
+    0x49, 0x81, 0x72, 0xAC, 0x48, 0xA9, 0x54, 0x84, 0x67, 0x81, 0x66, 0x9B, 0x41, 0x80, 0x49, 0x81,
+    0x57, 0x91, 0x4B, 0xBF, 0x84, 0x48, 0xAC, 0x48, 0x8E, 0x41, 0xC0, 0x44, 0xC0, 0x43, 0xC1, 0x7F,
+    0x76, 0xC1, 0x42, 0xC0, 0x40, 0xC3, 0x85, 0x41, 0x81, 0xC1, 0x45, 0xC5, 0x48, 0x80, 0xC5, 0x40,
+    0x81, 0x40, 0xC3, 0x43, 0x81, 0x44, 0x82, 0x49, 0xC3, 0x81, 0x45, 0x83, 0xC5, 0x40, 0x89, 0x51,
+    0x82, 0x44, 0x83, 0x43, 0x81, 0x41, 0x83, 0x43, 0xCA, 0x42, 0xC0, 0x45, 0xC0, 0x44, 0xC6, 0x43,
+    0xC3, 0x47, 0xC1, 0x42, 0xC2, 0x51, 0x86, 0x4E, 0x80, 0x41, 0x82, 0x40, 0x80, 0x5B, 0x80, 0xC1,
+    0x44, 0x8A, 0xC2, 0x41, 0xC1, 0x5B, 0x9D, 0x43, 0x81, 0x48, 0x80, 0x41, 0x82, 0x41, 0x81, 0xC1,
+    0x42, 0xC0, 0x44, 0x86, 0xC0, 0x43, 0xC1, 0x83, 0x4E, 0x80, 0x41, 0x82, 0x40, 0x80, 0x42, 0xC3,
+    0x43, 0x89, 0xC2, 0x45, 0xC3, 0x43, 0xC1, 0x4F, 0xC5, 0x40, 0x83, 0xC5, 0x41, 0x83, 0x51, 0x81,
+    0x4A, 0x81, 0x42, 0xC0, 0x40, 0x83, 0xC3, 0x81, 0x41, 0x83, 0x45, 0xCA, 0xCA, 0x40, 0x81, 0x40,
+    0x83, 0x43, 0x81, 0x44, 0x84, 0x40, 0x85, 0xC2, 0x44, 0xC0, 0x43, 0xC1, 0x8A, 0x40, 0xC5, 0x41,
+    0xC6, 0x4E, 0x9E, 0x48, 0x82, 0x42, 0xC0, 0x40, 0x89, 0x51, 0x82, 0x42, 0x80, 0x40, 0x89, 0x41,
+    0x81, 0xC1, 0x5D, 0xA3, 0x48, 0x82, 0x42, 0xC0, 0x40, 0x81, 0xC1, 0x42, 0xC0, 0x44, 0x83, 0x43,
+    0x81, 0xC1, 0x45, 0xC3, 0x4B, 0x81, 0x42, 0xC0, 0x40, 0x81, 0x74, 0xA3, 0x48, 0x80, 0xC1, 0x42,
+    0xC0, 0x40, 0xBF, 0x43, 0x4D, 0x86, 0x4A, 0x80, 0xC1, 0x42, 0xC0, 0x5C, 0x82, 0x42, 0x80, 0x44,
+    0x86, 0x40, 0xC3, 0x43, 0x81, 0x42, 0xC0, 0x40, 0x89, 0x41, 0x83, 0x45, 0xC3, 0x81, 0x48, 0x82,
+    0x42, 0xC0, 0x40, 0x81, 0x5C, 0x85, 0x48, 0x82, 0x42, 0xC0, 0x40, 0x89, 0x51, 0x82, 0x42, 0x80,
+    0x40, 0x8A, 0x40, 0x83, 0x5E, 0x81, 0x42, 0xC0, 0x40, 0x83, 0xC3, 0x43, 0x83, 0x44, 0x99, 0x40,
+    0x81, 0xC3, 0x41, 0x81, 0x44, 0x82, 0x47, 0xC1, 0x42, 0xC0, 0x44, 0xC5, 0x4D, 0x84, 0x40, 0x81,
+    0x41, 0x81, 0x4A, 0xC4, 0x41, 0x83, 0x43, 0x81, 0x41, 0x83, 0x45, 0xC3, 0x81, 0x48, 0xC0, 0x81,
+    0x42, 0x80, 0x40, 0x81, 0x40, 0x81, 0x41, 0x83, 0x41, 0x83, 0x40, 0x84, 0x40, 0x85, 0x48, 0x80,
+    0x82, 0x47, 0x84, 0xC0, 0x43, 0xC1, 0x81, 0xC1, 0x42, 0xC0, 0x43, 0x8B, 0x48, 0x8F, 0x44, 0x8A,
+    0x44, 0x81, 0x43, 0x85, 0x48, 0x80, 0x49, 0x81, 0x41, 0x81, 0x41, 0x89, 0x41, 0x80, 0x4A, 0x81,
+    0x48, 0x82, 0x44, 0x9C, 0x41, 0x83, 0x40, 0x8A, 0x40, 0x81, 0x41, 0x83, 0x48, 0x91, 0x4A, 0x90,
+    0x48, 0x91, 0x42, 0x84, 0x40, 0x81, 0xC3, 0x4A, 0xC6, 0x41, 0xC9, 0x54, 0x8D, 0x40, 0x83, 0x43,
+    0xC4, 0x41, 0x84, 0x40, 0x84, 0xC5, 0x40, 0x83, 0xC6, 0x40, 0x83, 0x47, 0x84, 0x40, 0x81, 0x41,
+    0x90, 0x48, 0x8E, 0xC2, 0x44, 0xC0, 0xCB, 0xA1, 0x43, 0xC1, 0x48, 0x82, 0x42, 0x80, 0x40, 0x89,
+    0x51, 0x80, 0x46, 0x83, 0x43, 0x81, 0x41, 0x83, 0x5D, 0x9D, 0x43, 0x81, 0x49, 0x81, 0x42, 0x80,
+    0x40, 0x81, 0xC1, 0x44, 0xC3, 0x85, 0x4B, 0xC5, 0x48, 0x80, 0x7D, 0x9D, 0x43, 0x81, 0x48, 0x80,
+    0x46, 0xBF, 0x51, 0x88, 0x48, 0x80, 0x62, 0x82, 0x44, 0x81, 0x88, 0x48, 0x81, 0x42, 0x80, 0x40,
+    0x83, 0xC5, 0x41, 0x83, 0x45, 0xC5, 0x48, 0xC0, 0x81, 0x42, 0x80, 0x40, 0x81, 0x5C, 0x85, 0x48,
+    0xC0, 0x81, 0x42, 0x80, 0x40, 0x89, 0x51, 0x82, 0x42, 0x80, 0x40, 0x83, 0x43, 0x81, 0x41, 0x87,
+    0x5A, 0xC1, 0x42, 0xC0, 0x40, 0xC9, 0x4A, 0xBF, 0xBF, 0xBF, 0xBF, 0x94, 0xBF, 0xBF, 0xBF, 0xBF,
+    0xBF, 0xBF, 0xBF, 0x9D, 0x41, 0x82, 0x40, 0xC4, 0x43, 0xC1, 0x50, 0xCA, 0x41, 0x82, 0x40, 0x80,
+    0x41, 0x80, 0x43, 0x81, 0x43, 0x83, 0x40, 0x82, 0x4F, 0x88, 0x40, 0x81, 0x42, 0x80, 0x40, 0x89,
+    0x51, 0x80, 0x41, 0x83, 0x40, 0x87, 0x41, 0x80, 0x40, 0x87, 0xC0, 0x43, 0x81, 0xC3, 0x44, 0xC2,
+    0x87, 0x41, 0xC2, 0x40, 0xC0, 0x43, 0xC5, 0x40, 0x8C, 0x49, 0x81, 0x45, 0x86, 0x4E, 0x80, 0x41,
+    0x82, 0x40, 0x80, 0x5B, 0x80, 0x41, 0x83, 0x40, 0x8B, 0x43, 0x81, 0x5B, 0xA1, 0x41, 0x89, 0x41,
+    0x83, 0x40, 0x81, 0x4A, 0x91, 0x4E, 0x89, 0x44, 0x81, 0x41, 0x91, 0x4A, 0xC2, 0x40, 0xC3, 0x47,
+    0xD1, 0x4E, 0x83, 0x43, 0x81, 0x4A, 0x81, 0x42, 0x80, 0x40, 0x83, 0x43, 0xC2, 0x40, 0x89, 0xCF,
+    0x81, 0x42, 0x80, 0x40, 0x81, 0x40, 0x87, 0x41, 0x83, 0x40, 0x8E, 0x44, 0xC0, 0x43, 0xC7, 0x84,
+    0xC0, 0x43, 0xCD, 0xA2, 0x40, 0xC5, 0x41, 0x81, 0x42, 0xC0, 0x45, 0xC7, 0x42, 0xC0, 0x44, 0xC3,
+    0x43, 0x81, 0xC3, 0x45, 0x84, 0x40, 0x83, 0x4C, 0x81, 0x42, 0xC0, 0x40, 0x89, 0x41, 0x81, 0xCB,
+    0x81, 0x48, 0x82, 0x42, 0xC0, 0x40, 0x81, 0x40, 0x81, 0xC5, 0x81, 0x44, 0x84, 0x40, 0x85, 0xC1,
+    0x40, 0xC4, 0x42, 0x81, 0x41, 0x85, 0xC5, 0x41, 0xC3, 0x81, 0x44, 0xC0, 0x83, 0x41, 0xC0, 0x51,
+    0x8F, 0x42, 0xC0, 0x44, 0x86, 0x42, 0xC3, 0x43, 0x83, 0x4A, 0x80, 0x44, 0xC0, 0x43, 0x81, 0xC1,
+    0x43, 0x89, 0x41, 0xC7, 0x82, 0x82, 0x48, 0x82, 0x42, 0xC0, 0x40, 0x9E, 0x44, 0x8A, 0x40, 0x81,
+    0xC5, 0x42, 0xC1, 0x41, 0x8D, 0xC0, 0x49, 0xC0, 0x8C, 0x43, 0xC1, 0x82, 0x42, 0xC5, 0x8B, 0xC5,
+    0x42, 0x84, 0x40, 0x81, 0xC3, 0x4B, 0x81, 0xC3, 0x41, 0xC5, 0x46, 0x88, 0x48, 0x8D, 0x40, 0x81,
+    0xC5, 0x81, 0x42, 0xC0, 0x40, 0x84, 0x40, 0x84, 0xC5, 0x40, 0x83, 0xC3, 0x81, 0x41, 0x81, 0xC8,
+    0x40, 0x84, 0x40, 0x83, 0x59, 0x8E, 0x42, 0x84, 0xC0, 0x41, 0xC3, 0x85, 0x5F, 0xC1, 0x42, 0xC0,
+    0x44, 0x83, 0x43, 0x81, 0xC3, 0x49, 0x88, 0x40, 0xC5, 0x40, 0x81, 0x42, 0xC1, 0x43, 0x81, 0x42,
+    0x80, 0x45, 0xCB, 0x81, 0x48, 0x80, 0xC5, 0x40, 0x85, 0x55, 0x82, 0x42, 0xC0, 0x40, 0x8A, 0x40,
+    0x81, 0xC6, 0x41, 0xC3, 0x81, 0x44, 0xC0, 0x83, 0x41, 0xC5, 0x41, 0xC3, 0x84, 0x45, 0x80, 0x40,
+    0x81, 0xC6, 0x81, 0xC0, 0x4B, 0x85, 0xCA, 0x4A, 0x80, 0x41, 0xC3, 0x80, 0x5B, 0x80, 0xC1, 0x42,
+    0xC0, 0x44, 0x86, 0xC6, 0x5B, 0x9D, 0xC3, 0x81, 0x48, 0x80, 0xC5, 0x40, 0x81, 0x44, 0xC0, 0x8B,
+    0xC0, 0x41, 0xC3, 0x83, 0x45, 0x89, 0x41, 0xC3, 0x82, 0x42, 0xC1, 0x41, 0x8B, 0xC7, 0x40, 0x81,
+    0xC3, 0x46, 0xC0, 0x46, 0x84, 0xC5, 0x40, 0x83, 0xC3, 0x43, 0x81, 0xC6, 0x59, 0x81, 0x42, 0xC0,
+    0x40, 0x8A, 0x40, 0x81, 0xCB, 0x81, 0x48, 0x80, 0xC5, 0x40, 0x81, 0x40, 0x81, 0x81, 0x43, 0x8B,
+    0x40, 0x85, 0x41, 0xC0, 0x44, 0x80, 0x43, 0xC1, 0x85, 0x45, 0x81, 0xC5, 0x41, 0xC3, 0x85, 0x40,
+    0xA0, 0x42, 0x84, 0x40, 0x83, 0x4F, 0x81, 0x43, 0x81, 0x42, 0xC0, 0x58, 0x8D, 0x40, 0x81, 0xC5,
+    0x81, 0x44, 0x84, 0x40, 0x86, 0x42, 0xC0, 0x40, 0x83, 0xC3, 0x81, 0x41, 0x83, 0x47, 0x84, 0x40,
+    0x81, 0x41, 0x90, 0x48, 0x90, 0x48, 0x81, 0x41, 0xA5, 0x40, 0x83, 0x43, 0x89, 0x47, 0x81, 0x42,
+    0x80, 0x44, 0x86, 0x4C, 0x91, 0x44, 0x81, 0x44, 0x8A, 0x40, 0x83, 0x45, 0x98, 0x40, 0x81, 0x41,
+    0x8F, 0x40, 0x85, 0x40, 0x47, 0x90, 0x46, 0x97, 0x48, 0x91, 0x48, 0x8E, 0x42, 0x84, 0x40, 0x81,
+    0xC3, 0x69, 0x84, 0x40, 0x81, 0xCE, 0x40, 0x81, 0xCB, 0x40, 0x84, 0x40, 0x90, 0x40, 0xAC, 0x48,
+    0xA9, 0x48, 0x83, 0x47, 0x84, 0x48, 0xC1, 0x44, 0xC2, 0x41, 0x80, 0x51, 0x8D, 0xC4, 0x43, 0xC1,
+    0x42, 0x80, 0x40, 0xC4, 0x45, 0xC1, 0x42, 0x80, 0x40, 0x89, 0x4D, 0x84, 0x40, 0x83, 0x59, 0x8E,
+    0x42, 0x84, 0x40, 0x81, 0x41, 0x81, 0x65, 0xC2, 0x5E, 0x83, 0x47, 0x81, 0x46, 0xCA, 0x41, 0x81,
+    0xCC, 0x42, 0x80, 0x40, 0xC3, 0x85, 0x41, 0xC1, 0x81, 0x45, 0x98, 0xC4, 0x41, 0xC1, 0x46, 0xC4,
+    0x40, 0xD0, 0x41, 0x81, 0xCA, 0x80, 0x43, 0x81, 0x43, 0x84, 0x44, 0x80, 0x51, 0x91, 0x48, 0x8E,
+    0x48, 0x83, 0x47, 0xA0, 0x48, 0x83, 0x47, 0x84, 0xC0, 0x47, 0xC1, 0x42, 0x80, 0x40, 0xC2, 0x8B,
+    0x48, 0xAC, 0x48, 0x8D, 0x5B, 0x81, 0xC1, 0x43, 0x81, 0x44, 0x82, 0x41, 0xC0, 0x44, 0x81, 0x44,
+    0x83, 0x43, 0x81, 0x41, 0x81, 0x41, 0x84, 0x42, 0xC4, 0x40, 0x83, 0x47, 0xC6, 0x42, 0x80, 0x40,
+    0x8A, 0xC0, 0x49, 0x85, 0x48, 0x80, 0x46, 0x81, 0x40, 0xC1, 0x81, 0x43, 0x89, 0xC1, 0x49, 0x84,
+    0x40, 0x81, 0x41, 0x81, 0x4B, 0x81, 0x41, 0x83, 0x41, 0x83, 0x40, 0x84, 0x40, 0x88, 0x48, 0x8D,
+    0xC1, 0x44, 0xC3, 0x47, 0xC3, 0x49, 0x81, 0x49, 0x81, 0x44, 0x81, 0xC4, 0x41, 0xC3, 0x44, 0xCC,
+    0x85, 0x48, 0x80, 0xC1, 0x42, 0x80, 0x40, 0xC9, 0x92, 0xC1, 0x42, 0x80, 0x40, 0xC3, 0x86, 0xC4,
+    0x41, 0xC4, 0x41, 0x81, 0x43, 0x84, 0x44, 0xC5, 0x41, 0x83, 0x40, 0x87, 0x41, 0x80, 0x40, 0x81,
+    0x41, 0x84, 0xCA, 0x41, 0x81, 0xC9, 0x4A, 0x83, 0x47, 0x84, 0x40, 0x81, 0x41, 0x85, 0x44, 0x8E,
+    0x48, 0x8D, 0x48, 0x91, 0x46, 0x94, 0x48, 0x94, 0x48, 0x90, 0x40, 0x84, 0x40, 0x81, 0x41, 0xAB,
+    0x48, 0x91, 0x44, 0xC0, 0x43, 0x81, 0xC5, 0xA0, 0xC1, 0x45, 0xC0, 0x45, 0xC5, 0x6C, 0xAC, 0x48,
+    0xA9, 0xC1, 0x80, 0x44, 0x80, 0x43, 0x81, 0xC5, 0x82, 0x69, 0x8D, 0x5A, 0x9B, 0xC1, 0x45, 0x80,
+    0x43, 0x81, 0xC5, 0x51, 0x91, 0x44, 0x80, 0x43, 0x81, 0xC5, 0xBE, 0x48, 0xAC, 0x48, 0x90, 0x45,
+    0xC0, 0x45, 0xC5, 0xBF, 0xB0, 0xC2, 0x43, 0xC3, 0x43, 0xC5, 0x4B, 0xC4, 0x43, 0xC1, 0x40, 0x80,
+    0x44, 0x46, 0x84, 0x40, 0xC1, 0x81, 0x41, 0xC5, 0x44, 0xC1, 0x42, 0x80, 0xC4, 0x83, 0xC1, 0x43,
+    0x83, 0xC3, 0x83, 0xC1, 0x48, 0x80, 0x44, 0x80, 0x43, 0xC1, 0x83, 0xC1, 0x81, 0x42, 0x80, 0x40,
+    0xC2, 0x42, 0x85, 0xC1, 0x80, 0x44, 0xC2, 0x41, 0x81, 0xC5, 0x84, 0xC2, 0x41, 0x81, 0x43, 0x83,
+    0xC3, 0x41, 0x80, 0x51, 0x8D, 0xC1, 0x43, 0xC4, 0x43, 0xC1, 0x41, 0xC1, 0x4B, 0xC1, 0x50, 0x81,
+    0xC4, 0x41, 0xC1, 0x41, 0x82, 0x40, 0xC5, 0x40, 0xC6, 0x83, 0xC1, 0x48, 0x82, 0x42, 0x80, 0x40,
+    0xC9, 0x92, 0xC1, 0x42, 0x80, 0xC4, 0x43, 0xC1, 0x41, 0xC1, 0x83, 0xC4, 0x41, 0x81, 0xC1, 0x41,
+    0x83, 0xC5, 0x80, 0x46, 0x83, 0xC8, 0x41, 0x81, 0x43, 0x81, 0x42, 0xCA, 0x41, 0x81, 0xCB, 0x48,
+    0x83, 0x47, 0x84, 0x48, 0x81, 0x44, 0xC2, 0x8B, 0x48, 0x89, 0x46, 0x83, 0xC1, 0x81, 0x42, 0x80,
+    0x40, 0xC2, 0x87, 0x44, 0x80, 0xC0, 0x43, 0x83, 0xC1, 0x40, 0x89, 0x42, 0x84, 0x40, 0x85, 0x57,
+    0x8E, 0x41, 0x80, 0x45, 0x81, 0x41, 0x81, 0x45, 0x9F, 0x45, 0xC4, 0x43, 0xC1, 0x40, 0x80, 0x4F,
+    0x88, 0x42, 0x82, 0x41, 0x81, 0x46, 0xC1, 0x46, 0xC4, 0x47, 0x83, 0x4A, 0x80, 0x44, 0x81, 0x5B,
+    0x82, 0x42, 0x80, 0x40, 0xC3, 0x86, 0x42, 0x83, 0xC4, 0x41, 0x81, 0x43, 0x83, 0xC3, 0x41, 0x80,
+    0x46, 0x83, 0x40, 0x87, 0x41, 0x80, 0x40, 0x81, 0x41, 0x84, 0xC1, 0x80, 0x44, 0x80, 0x43, 0x81,
+    0xCC, 0x45, 0x88, 0x42, 0x82, 0x40, 0xCA, 0x51, 0x80, 0xC1, 0x43, 0xC4, 0x43, 0xC1, 0x40, 0xC4,
+    0x41, 0xC9, 0x4D, 0x43, 0xA1, 0xC1, 0x48, 0x80, 0xC1, 0x42, 0x80, 0xC2, 0x41, 0x83, 0xC8, 0x41,
+    0x80, 0xC2, 0x41, 0x81, 0x49, 0x89, 0x41, 0x83, 0x40, 0x81, 0xC2, 0x41, 0x81, 0xC1, 0x41, 0x83,
+    0xCB, 0x80, 0x4E, 0x8A, 0x41, 0x82, 0x41, 0x83, 0x43, 0x81, 0x40, 0x8B, 0x52, 0x84, 0x44, 0x80,
+    0x44, 0x91, 0x4E, 0x89, 0x42, 0x83, 0x41, 0x92, 0x41, 0x80, 0x44, 0x80, 0x43, 0x81, 0x45, 0x84,
+    0x40, 0x81, 0x41, 0x83, 0x41, 0x83, 0x40, 0xA6, 0x42, 0x84, 0x40, 0xC1, 0x81, 0x41, 0xC5, 0x4B,
+    0xC3, 0x43, 0xC3, 0x81, 0x52, 0x8D, 0x40, 0xC1, 0x83, 0xC3, 0x42, 0x80, 0xC3, 0x42, 0x86, 0x42,
+    0x80, 0x40, 0xC3, 0x83, 0xC1, 0x43, 0x83, 0x45, 0x84, 0x40, 0xC1, 0x83, 0xCE, 0x48, 0x8E, 0xC1,
+    0x80, 0x44, 0xC2, 0x41, 0x81, 0xC5, 0x9F, 0x40, 0xC1, 0x43, 0xC1, 0x41, 0x82, 0x40, 0xC3, 0x4E,
+    0xC3, 0x43, 0xC1, 0x4D, 0x84, 0xC2, 0x41, 0x81, 0xC5, 0x44, 0x81, 0x42, 0x80, 0x40, 0xC3, 0x43,
+    0xC1, 0x41, 0x85, 0x43, 0x98, 0x40, 0xC1, 0x83, 0xC1, 0x41, 0x83, 0xC3, 0x42, 0x85, 0xC1, 0x80,
+    0x44, 0xC2, 0x41, 0x81, 0xC5, 0x85, 0x43, 0x81, 0xC1, 0x41, 0x83, 0xC3, 0x8B, 0x48, 0x91, 0x48,
+    0x8E, 0xC1, 0x46, 0xC1, 0x81, 0x41, 0xC5, 0xA0, 0x42, 0x84, 0x40, 0xC1, 0x83, 0xCA, 0x42, 0x83,
+    0xC3, 0x42, 0x80, 0xC3, 0x91, 0x42, 0x86, 0x6E, 0xAC, 0x48, 0x8E, 0x4C, 0x81, 0x68, 0xC0, 0x51,
+    0x84, 0x67, 0xAC, 0x48, 0xA9, 0x47, 0x80, 0x43, 0x87, 0xC4, 0x67, 0x8D, 0x5A, 0x9B, 0xC2, 0x51,
+    0xC8, 0x48, 0x85, 0x4A, 0x80, 0x44, 0x80, 0x43, 0x87, 0x7F, 0x47, 0xAC, 0x48, 0x8E, 0x41, 0x80,
+    0x51, 0xBF, 0xB1, 0x42, 0x84, 0x40, 0x83, 0x4D, 0x83, 0x43, 0x81, 0x44, 0x84, 0x40, 0x88, 0x48,
+    0x8D, 0x40, 0x81, 0xC1, 0x43, 0x89, 0x41, 0xC0, 0x44, 0x81, 0x42, 0x80, 0x40, 0x8A, 0x40, 0x81,
+    0x49, 0xC5, 0x8B, 0xC8, 0x48, 0x90, 0x40, 0x84, 0x40, 0x81, 0x41, 0x83, 0x64, 0x83, 0x50, 0xC4,
+    0x81, 0x44, 0x83, 0x47, 0x83, 0x47, 0xC4, 0x40, 0x83, 0x47, 0xC4, 0x81, 0x42, 0x80, 0x40, 0x8A,
+    0x40, 0xC3, 0x45, 0x98, 0x40, 0xC3, 0x43, 0x89, 0xC8, 0x42, 0x85, 0x43, 0x87, 0x45, 0x81, 0x41,
+    0x83, 0x41, 0x89, 0x40, 0x88, 0x48, 0x91, 0x48, 0x90, 0x40, 0x84, 0x40, 0x83, 0x71, 0x90, 0x40,
+    0x81, 0x45, 0x95, 0x48, 0xB4, 0x40, 0x9E, 0xBF, 0xBF, 0xBF, 0xBF, 0xBF, 0xBF, 0xBF, 0xBF, 0xBF,
+    0xBF, 0xBF, 0xA2
+};
@@ -0,0 +1,12 @@
+#ifndef TABLEBASE_3X3_H
+#define TABLEBASE_3X3_H
+
+// Generated by tablebase_compress: 3x3, 3 in a row, BlockTablebase.h format
+
+#include "BlockTablebase.h"
+
+#define TABLEBASE_3X3 tablebase3x3
+
+extern const uint8_t tablebase3x3[3219] PROGMEM;
+
+#endif
@@ -1,246 +1,399 @@
 #include <Arduino.h>
+#include "Engines.h"
+#include "GameProtocol.h"
+#include "SerialInput.h"
 
-const int BOARD_SIZE = 3;
-const char PLAYER_X = 'X';
-const char PLAYER_O = 'O';
-const int MODE_MAN_VS_MAN = 1;
-const int MODE_MAN_VS_AI = 2;
-const int MODE_AI_VS_AI = 3;
+// The pool gets 1/8 of SRAM, the rest is left for the minimax recursion and serial buffers.
+// A GameSession is 11 bytes on the AVR: 23 slots on the Uno, the 64-slot cap on the Mega
+#if defined(RAMEND) && defined(RAMSTART)
+const uint16_t SESSION_POOL_BYTES = (RAMEND - RAMSTART + 1) / 8;
+#else
+const uint16_t SESSION_POOL_BYTES = 256;
+#endif
+const uint8_t MAX_SESSION_SLOTS = 64;
+const uint8_t SESSION_SLOTS = (SESSION_POOL_BYTES / sizeof(GameSession) < MAX_SESSION_SLOTS)
+    ? SESSION_POOL_BYTES / sizeof(GameSession) : MAX_SESSION_SLOTS;
 
-char board[BOARD_SIZE][BOARD_SIZE] = { {'1', '2', '3'}, {'4', '5', '6'}, {'7', '8', '9'} };
-bool isGameStarted = false;
-int gameMode = 0; // 1 - Man vs Man, 2 - Man vs AI, 3 - AI vs AI
-int lastServerMove = -1; // Last move of the AI
-int playerCount = 0;
+// A reply is assembled in one buffer and sent in one writeSerialOutput() call. A move reply
+// with the board and telemetry is up to 205 bytes, 241 with "#c " channel prefixes; longer
+// ones (subscribed events, "@N " prefixes) go out in buffer-sized pieces
+#ifndef REPLY_BUFFER_SIZE
+#define REPLY_BUFFER_SIZE 256
+#endif
 
-char globalCurrentPlayer = PLAYER_X;
+// Longest command line, "@63 SetPosition XXXXXXXXX" needs 26
+const uint8_t COMMAND_LINE_SIZE = 40;
 
-void setup() {
-    Serial.begin(9600);
-}
+GameSession sessions[SESSION_SLOTS];
+unsigned long lastAutoPlayStep = 0;
+char commandLine[COMMAND_LINE_SIZE]; // Line being received, without the '\n'
+uint8_t commandLength = 0;
+bool isCommandTooLong = false;
 
-void loop() {
-    if (Serial.available() > 0) {
-        String command = Serial.readStringUntil('\n');
+// Health counters for the "Stats" command
+struct ServerStats {
+    unsigned long worstLoopMicros;
+    uint32_t txBytes;
+    unsigned long worstTxMicros; // Longest writeSerialOutput() of a reply
+    uint32_t commands;
+    uint32_t invalidCommands;    // Commands answered with "Invalid..."
+};
 
-        if (command == "StartGame") {
-            startGame();
-        } else if (command.startsWith("SetMode ")) {
-            setGameMode(command);
-        }
+ServerStats stats;
 
-        if (gameMode == MODE_MAN_VS_MAN) {
-            handleManvsMan(command);
-        } 
-        if (gameMode == MODE_MAN_VS_AI) {
-            handleManvsAI(command);
-        }
-        if (gameMode == MODE_AI_VS_AI) {
-            handleAIvsAI(command);
-        }  
-    }
+#ifdef __AVR__
+extern char __heap_start;
+extern char* __brkval;
+
+const uint8_t STACK_CANARY = 0xC5;
+const uint8_t STACK_PAINT_MARGIN = 32; // Bytes below the stack pointer left for interrupts
+#define HEAP_END (__brkval ? __brkval : &__heap_start)
+#endif
+
+// Bytes between the heap and the stack, 0 off the AVR
+uint16_t freeSram() {
+#ifdef __AVR__
+    char top;
+    return &top - HEAP_END;
+#else
+    return 0;
+#endif
 }
 
-void startGame() {
-    resetBoard();
-    isGameStarted = true;
-    Serial.println("GameStarted");
-    printBoardGraphically();
+// Fills the free SRAM with a canary; whatever the stack or the heap has not overwritten since
+// is the minimum free SRAM since boot, including the deepest minimax recursion
+void paintFreeSram() {
+#ifdef __AVR__
+    char top;
+    for (char* p = HEAP_END; p < &top - STACK_PAINT_MARGIN; p++) {
+        *p = STACK_CANARY;
+    }
+#endif
 }
 
-void setGameMode(const String& command) {
-    String mode = command.substring(8);
-    gameMode = mode.toInt();
-    Serial.println("Mode set to " + mode);    
+uint16_t minFreeSram() {
+#ifdef __AVR__
+    char* p = HEAP_END;
+    while (*p == (char)STACK_CANARY) {
+        p++;
+    }
+    return p - HEAP_END;
+#else
+    return 0;
+#endif
 }
 
-void handleManvsMan(String command) {
-    if (command.startsWith("Move") && isGameStarted) {
-        int position = command.substring(5).toInt();
+const char INVALID_PREFIX[] PROGMEM = "Invalid";
+const uint8_t INVALID_PREFIX_LENGTH = sizeof(INVALID_PREFIX) - 1;
 
-        char player = (playerCount % 2 == 0) ? PLAYER_X : PLAYER_O;
+// "Channels On" multiplexes the UART: every line starts with "#<channel> " and the lines of
+// a reply are sent in channel order, so the lines a player waits for go out first
+enum Channel {
+    CHANNEL_EVENTS,    // "Event ..." pushed to subscribers
+    CHANNEL_RESPONSES, // Replies to commands
+    CHANNEL_TELEMETRY, // "Telemetry ..." after AI moves
+    CHANNEL_COUNT
+};
 
-        if (makePlayerMove(position, player)) {
-            printBoardGraphically();
-            checkGameStatus();
-            playerCount++;
-        } else {
-            Serial.println("InvalidMove");
-        }
-    }
-}
+const char EVENT_PREFIX[] PROGMEM = "Event ";
+const char TELEMETRY_PREFIX[] PROGMEM = "Telemetry nodes=";
 
-void handleManvsAI(String command) {
-    if (command.startsWith("Move") && isGameStarted) {
-        int position = command.substring(5).toInt();
-        
-        if (makePlayerMove(position, PLAYER_X)) {
-            if (!checkGameStatus()) {
-                int aiMove[2];
-                bestMove(PLAYER_O, aiMove);
-                makeAIMove(aiMove, PLAYER_O);
-                printBoardGraphically();
-                checkGameStatus();
+// Collects replies for Serial, flush() sends them. Lines of session N > 0 are prefixed
+// with "@N ", session 0 keeps the original unprefixed protocol
+class ReplyPrint : public Print {
+public:
+    int8_t sessionId = 0;
+    bool isMultiplexed = false;
+
+    size_t write(uint8_t c) override {
+        if (isAtLineStart && isMultiplexed) {
+            append('#');
+            append('0' + CHANNEL_RESPONSES); // Set by finishLine()
+            append(' ');
+        }
+        if (isAtLineStart && sessionId > 0) {
+            append('@');
+            if (sessionId >= 10) {
+                append('0' + sessionId / 10);
+            }
+            append('0' + sessionId % 10);
+            append(' ');
+        }
+        // "Invalid" at the start of any reply line marks the command as invalid
+        if (isAtLineStart) {
+            invalidPrefixLength = 0;
+        }
+        if (invalidPrefixLength < INVALID_PREFIX_LENGTH && c == pgm_read_byte(&INVALID_PREFIX[invalidPrefixLength])) {
+            if (++invalidPrefixLength == INVALID_PREFIX_LENGTH) {
+                isInvalid = true;
             }
         } else {
-            Serial.println("InvalidMove");
+            invalidPrefixLength = INVALID_PREFIX_LENGTH + 1;
+        }
+        if (isAtLineStart) {
+            lineTextStart = length;
+        }
+        isAtLineStart = (c == '\n');
+        append(c);
+        if (isAtLineStart && isMultiplexed) {
+            finishLine();
         }
+        return 1;
     }
-}
+    using Print::write;
 
-void handleAIvsAI(String command) {
-    if (isGameStarted) {
-        globalCurrentPlayer = PLAYER_X;  // Почнемо з гравця X
+    void flush() {
+        cutLine();
+        send(length);
+    }
 
-        while (!checkGameStatus()) {  // Цикл поки гра не закінчиться
-            int aiMove[2];
-            bestMove(globalCurrentPlayer, aiMove);
-            makeAIMove(aiMove, globalCurrentPlayer);  // Виконуємо хід поточного гравця
-            printBoardGraphically();
+    // Whether a reply line started with "Invalid" since the last call
+    bool takeInvalid() {
+        bool wasInvalid = isInvalid;
+        isInvalid = false;
+        return wasInvalid;
+    }
 
-            delay(500); 
-            // Перевіряємо статус гри після кожного ходу
-            if (checkGameStatus()) break;
+private:
+    void append(uint8_t c) {
+        if (length == REPLY_BUFFER_SIZE) {
+            makeRoom();
+        }
+        buffer[length++] = c;
+    }
 
-            // Змінюємо поточного гравця
-            globalCurrentPlayer = opponent(globalCurrentPlayer);
+    // Sends the complete lines of a full buffer and keeps the line being written
+    void makeRoom() {
+        if (isMultiplexed && lineStart > 0) {
+            send(lineStart);
+        } else {
+            flush();
         }
     }
-}
 
-bool makePlayerMove(int position, char player) {
-    if (isPositionValid(position)) {
-        int row = (position - 1) / BOARD_SIZE;
-        int col = (position - 1) % BOARD_SIZE;
-        board[row][col] = player;
-        return true;
+    // A line that is sent before its '\n' gets the channel of what is known of it
+    void cutLine() {
+        if (!isMultiplexed || lineStart == length) {
+            return;
+        }
+        if (!isLineContinued && lineTextStart > lineStart) {
+            buffer[lineStart + 1] = '0' + channelOf(buffer + lineTextStart, length - lineTextStart);
+        }
+        isLineContinued = true;
     }
-    return false;
-}
 
-void makeAIMove(int aiMove[2], char player) {
-    board[aiMove[0]][aiMove[1]] = player;
-    lastServerMove = aiMove[0] * BOARD_SIZE + aiMove[1] + 1;
-    Serial.println("ServerMove: " + String(lastServerMove));
-}
+    // Sends the first size bytes and moves the rest to the front
+    void send(uint16_t size) {
+        if (size == 0) {
+            return;
+        }
+        unsigned long start = micros();
+        writeSerialOutput(buffer, size);
+        unsigned long txTime = micros() - start;
+        if (txTime > stats.worstTxMicros) {
+            stats.worstTxMicros = txTime;
+        }
+        stats.txBytes += size;
 
-bool isPositionValid(int position) {
-    int row = (position - 1) / BOARD_SIZE;
-    int col = (position - 1) % BOARD_SIZE;
-    return (position >= 1 && position <= 9 && board[row][col] != PLAYER_X && board[row][col] != PLAYER_O);
-}
+        length -= size;
+        memmove(buffer, buffer + size, length);
+        lineStart = (lineStart > size) ? lineStart - size : 0;
+        lineTextStart = (lineTextStart > size) ? lineTextStart - size : 0;
+        for (uint8_t channel = 0; channel < CHANNEL_COUNT; channel++) {
+            channelEnd[channel] = 0;
+        }
+    }
 
-bool checkGameStatus() {
-    if (checkWin(PLAYER_X)) {
-        Serial.println("X Wins");
-        return true;
-    } else if (checkWin(PLAYER_O)) {
-        Serial.println("O Wins");
-        return true;
-    } else if (isBoardFull()) {
-        Serial.println("Draw");
-        return true;
+    static uint8_t channelOf(const uint8_t* text, uint16_t size) {
+        if (size >= sizeof(EVENT_PREFIX) - 1 && memcmp_P(text, EVENT_PREFIX, sizeof(EVENT_PREFIX) - 1) == 0) {
+            return CHANNEL_EVENTS;
+        }
+        if (size >= sizeof(TELEMETRY_PREFIX) - 1 && memcmp_P(text, TELEMETRY_PREFIX, sizeof(TELEMETRY_PREFIX) - 1) == 0) {
+            return CHANNEL_TELEMETRY;
+        }
+        return CHANNEL_RESPONSES;
     }
-    return false;
-}
 
-void resetBoard() {
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            board[i][j] = '1' + (i * BOARD_SIZE + j);
+    static void reverse(uint8_t* first, uint8_t* last) {
+        while (first < --last) {
+            uint8_t c = *first;
+            *first++ = *last;
+            *last = c;
         }
     }
-    lastServerMove = -1;
-}
 
-bool checkWin(char player) {
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        if ((board[i][0] == player && board[i][1] == player && board[i][2] == player) ||
-            (board[0][i] == player && board[1][i] == player && board[2][i] == player)) {
-            return true;
+    // Moves the complete line at lineStart behind the lines of its channel. The buffer
+    // holds the events, then the responses, then the telemetry of the reply
+    void finishLine() {
+        uint8_t channel = CHANNEL_EVENTS;
+        if (isLineContinued) {
+            isLineContinued = false; // The start of the line is sent already, the rest goes first
+        } else {
+            channel = channelOf(buffer + lineTextStart, length - lineTextStart);
+            buffer[lineStart + 1] = '0' + channel;
+            uint8_t* target = buffer + channelEnd[channel];
+            reverse(target, buffer + lineStart);
+            reverse(buffer + lineStart, buffer + length);
+            reverse(target, buffer + length);
         }
+        uint16_t lineLength = length - lineStart;
+        for (uint8_t later = channel; later < CHANNEL_COUNT; later++) {
+            channelEnd[later] += lineLength;
+        }
+        lineStart = length;
     }
-    return (board[0][0] == player && board[1][1] == player && board[2][2] == player) ||
-           (board[0][2] == player && board[1][1] == player && board[2][0] == player);
+
+    uint8_t buffer[REPLY_BUFFER_SIZE];
+    uint16_t length = 0;
+    uint16_t channelEnd[CHANNEL_COUNT] = { 0 }; // End of the lines of each channel
+    uint16_t lineStart = 0;                     // Line being written, after all channels
+    uint16_t lineTextStart = 0;                 // Its text after the "#c " and "@N " prefixes
+    bool isLineContinued = false;               // Its start went out with the last flush()
+    bool isAtLineStart = true;
+    bool isInvalid = false;
+    uint8_t invalidPrefixLength = 0;
+};
+
+ReplyPrint reply;
+
+void setup() {
+    Serial.begin(9600);
+    beginSerialInput();
+    initEngines();
+    sessions[0].isInUse = true;
+    paintFreeSram();
 }
 
-bool isBoardFull() {
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            if (board[i][j] != PLAYER_X && board[i][j] != PLAYER_O) {
-                return false;
+// Commands may be addressed to a session: "@3 Move 5". Without the prefix they go to session 0.
+// A slot that OpenSession has not handed out answers InvalidSession
+void loop() {
+    unsigned long loopStart = micros();
+    pollSerialInput();
+
+    if (receiveCommandLine()) {
+        char* command = commandLine;
+        int sessionId = 0;
+
+        if (command[0] == '@') {
+            sessionId = atoi(command + 1);
+            char* space = strchr(command, ' ');
+            command = (space != NULL) ? space + 1 : commandLine + commandLength;
+        }
+
+        stats.commands++;
+        if (isCommandTooLong) {
+            reply.sessionId = 0;
+            reply.println(F("InvalidCommand"));
+        } else if (sessionId < 0 || sessionId >= SESSION_SLOTS || !sessions[sessionId].isInUse) {
+            reply.sessionId = 0;
+            reply.println(F("InvalidSession"));
+        } else {
+            reply.sessionId = sessionId;
+            if (strcmp_P(command, PSTR("Stats")) == 0) {
+                sendStats();
+            } else if (strncmp_P(command, PSTR("Channels "), 9) == 0) {
+                setChannels(command + 9);
+            } else if (strcmp_P(command, PSTR("OpenSession")) == 0) {
+                openSession();
+            } else if (strcmp_P(command, PSTR("CloseSession")) == 0) {
+                closeSession(sessionId);
+            } else {
+                handleCommand(sessions[sessionId], command, reply);
             }
         }
+        reply.flush();
+        if (reply.takeInvalid()) {
+            stats.invalidCommands++;
+        }
+        commandLength = 0;
+        isCommandTooLong = false;
+    }
+
+    if (millis() - lastAutoPlayStep >= AI_VS_AI_MOVE_DELAY) {
+        lastAutoPlayStep = millis();
+        for (int i = 0; i < SESSION_SLOTS; i++) {
+            if (sessions[i].isAutoPlaying) {
+                reply.sessionId = i;
+                stepAIvsAI(sessions[i], reply);
+                reply.flush();
+            }
+        }
+    }
+
+    unsigned long loopTime = micros() - loopStart;
+    if (loopTime > stats.worstLoopMicros) {
+        stats.worstLoopMicros = loopTime;
     }
-    return true;
 }
 
-void printBoardGraphically() {
-    Serial.println("-------------");
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        Serial.print("| ");
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            Serial.print(board[i][j]);
-            Serial.print(" | ");
+// Adds the received bytes to commandLine, true once the '\n' has arrived.
+// A line that does not fit is answered with InvalidCommand
+bool receiveCommandLine() {
+    int c;
+    while ((c = readSerialInput()) >= 0) {
+        if (c == '\n') {
+            commandLine[commandLength] = '\0';
+            return true;
+        }
+        if (commandLength < COMMAND_LINE_SIZE - 1) {
+            commandLine[commandLength++] = c;
+        } else {
+            isCommandTooLong = true;
         }
-        Serial.println();
-        Serial.println("-------------");
     }
-    Serial.println(); // Blank line after board output
+    return false;
 }
 
-char opponent(char player) {
-    return (player == PLAYER_X) ? PLAYER_O : PLAYER_X;
+// "Stats free=<bytes> minFree=<bytes> loopMaxUs=<us> rxMax=<bytes> rxDropped=<bytes> tx=<bytes> txMaxUs=<us> commands=<n> invalid=<n>"
+void sendStats() {
+    reply.print(F("Stats free="));
+    reply.print(freeSram());
+    reply.print(F(" minFree="));
+    reply.print(minFreeSram());
+    reply.print(F(" loopMaxUs="));
+    reply.print(stats.worstLoopMicros);
+    SerialInputStats input = serialInputStats();
+    reply.print(F(" rxMax="));
+    reply.print(input.highWater);
+    reply.print(F(" rxDropped="));
+    reply.print(input.dropped);
+    reply.print(F(" tx="));
+    reply.print(stats.txBytes);
+    reply.print(F(" txMaxUs="));
+    reply.print(stats.worstTxMicros);
+    reply.print(F(" commands="));
+    reply.print(stats.commands);
+    reply.print(F(" invalid="));
+    reply.println(stats.invalidCommands);
 }
 
-int minimax(char currentPlayer, char aiPlayer, int depth) {
-    if (checkWin(aiPlayer)) {
-        return 10 - depth; // AI wins
-    } else if (checkWin(opponent(aiPlayer))) {
-        return depth - 10; // Opponent wins
-    } else if (isBoardFull()) {
-        return 0; // Draw
-    }
-    int bestScore = (currentPlayer == aiPlayer) ? -1000 : 1000;
-
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            if (board[i][j] != PLAYER_X && board[i][j] != PLAYER_O) {
-                board[i][j] = currentPlayer; // Make the move
-                int score = minimax(opponent(currentPlayer), aiPlayer, depth + 1);
-                board[i][j] = '1' + (i * BOARD_SIZE + j); // Reset the move
-                if (currentPlayer == aiPlayer) {
-                    if (score > bestScore) {
-                        bestScore = score;
-                    }
-                } else {
-                    if (score < bestScore)
-                    {
-                        bestScore = score;
-                    }
-                }
-            }
-        }
+// Channels On|Off - multiplexing of all replies on the UART, not only of this session
+void setChannels(const char* state) {
+    if (strcmp_P(state, PSTR("On")) == 0 || strcmp_P(state, PSTR("Off")) == 0) {
+        reply.isMultiplexed = (state[1] == 'n');
+        reply.print(F("Channels "));
+        reply.println(state);
+    } else {
+        reply.println(F("InvalidChannels"));
     }
-    return bestScore;
 }
 
-void bestMove(char aiPlayer, int move[2]) {
-    int bestScore = -1000;
-    move[0] = -1;
-    move[1] = -1;
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            if (board[i][j] != PLAYER_X && board[i][j] != PLAYER_O) {
-                board[i][j] = aiPlayer;
-                int score = minimax(opponent(aiPlayer), aiPlayer, 0);
-                board[i][j] = '1' + (i * BOARD_SIZE + j);;
-                if (score > bestScore) {
-                    bestScore = score;
-                    move[0] = i;
-                    move[1] = j;
-                }
-            }
+// Claims a free slot and replies with its ID
+void openSession() {
+    for (int i = 1; i < SESSION_SLOTS; i++) {
+        if (!sessions[i].isInUse) {
+            sessions[i] = GameSession();
+            sessions[i].isInUse = true;
+            reply.print(F("Session "));
+            reply.println(i);
+            return;
         }
     }
-}
\ No newline at end of file
+    reply.println(F("NoFreeSession"));
+}
+
+void closeSession(int sessionId) {
+    sessions[sessionId] = GameSession();
+    sessions[sessionId].isInUse = (sessionId == 0);
+    reply.println(F("SessionClosed"));
+}